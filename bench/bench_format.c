@@ -0,0 +1,188 @@
+////////////////////////////////////////////
+// File    : bench_format.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Compares the String number appends and String$format
+// against snprintf into a temporary buffer followed by
+// String$append, which is what callers did before.
+//
+// Build with every file in src/ except main.c
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/string.h"
+#include "../src/rtti.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#define OPS 2000000u
+// Strings are cleared this often so they stay in cache
+#define OPS_PER_STRING 1000u
+
+static double ns_per_op(uint64_t start)
+{
+    return (double)(Bench$now_ns() - start) / OPS;
+}
+
+// Spread across every digit count, with some negatives
+static int64_t make_int(unsigned i)
+{
+    uint64_t x = (uint64_t)i * 0x9E3779B97F4A7C15ull;
+    return (int64_t)(x >> (i % 64)) * ((i & 1) ? -1 : 1);
+}
+
+static double make_double(unsigned i)
+{
+    return (double)make_int(i) / 1024.0 + 1.0 / (double)(i + 3);
+}
+
+static void reset(String *str, unsigned i)
+{
+    if (i % OPS_PER_STRING == 0)
+    {
+        Bench$sink += String$len(str);
+        String$free(str);
+    }
+}
+
+static void append_snprintf(String *str, const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    String$append(str, String$from_literal(buffer));
+}
+
+static void bench_ints(void)
+{
+    String str = String$new();
+    char buffer[64];
+    uint64_t start;
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        snprintf(buffer, sizeof(buffer), "%lld", (long long)make_int(i));
+        String$append(&str, String$from_literal(buffer));
+    }
+    printf("int     snprintf  %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        String$append_int(&str, make_int(i));
+    }
+    printf("int     append    %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        snprintf(buffer, sizeof(buffer), "%llx", (unsigned long long)make_int(i));
+        String$append(&str, String$from_literal(buffer));
+    }
+    printf("hex     snprintf  %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        String$append_hex(&str, (uint64_t)make_int(i));
+    }
+    printf("hex     append    %8.2f ns/op\n", ns_per_op(start));
+
+    String$free(&str);
+}
+
+static void bench_floats(void)
+{
+    String str = String$new();
+    char buffer[64];
+    uint64_t start;
+
+    // %.17g round-trips like append_double does, but isn't the shortest
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        snprintf(buffer, sizeof(buffer), "%.17g", make_double(i));
+        String$append(&str, String$from_literal(buffer));
+    }
+    printf("double  snprintf  %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        String$append_double(&str, make_double(i));
+    }
+    printf("double  append    %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        snprintf(buffer, sizeof(buffer), "%.9g", (float)make_double(i));
+        String$append(&str, String$from_literal(buffer));
+    }
+    printf("float   snprintf  %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        String$append_float(&str, (float)make_double(i));
+    }
+    printf("float   append    %8.2f ns/op\n", ns_per_op(start));
+
+    String$free(&str);
+}
+
+static void bench_format(void)
+{
+    String str = String$new();
+    String name = STR("player_one");
+    StringFormat format = StringFormat$compile("{} hit {} for {} damage at {}\n");
+    uint64_t start;
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        append_snprintf(&str, "%s hit %d for %.9g damage at %llu\n", String$cstr(&name),
+                        (int)(i % 1000), (float)make_double(i), (unsigned long long)i);
+    }
+    printf("format  snprintf  %8.2f ns/op\n", ns_per_op(start));
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < OPS; ++i)
+    {
+        reset(&str, i);
+        Any args[4] =
+        {
+            Any$ref_complex(&type_string, &name),
+            Any$from_int32((int32_t)(i % 1000)),
+            Any$from_float((float)make_double(i)),
+            Any$from_uint64(i),
+        };
+        String$format(&str, &format, 4, args);
+    }
+    printf("format  String    %8.2f ns/op\n", ns_per_op(start));
+
+    String$free(&str);
+}
+
+int main(void)
+{
+    bench_ints();
+    bench_floats();
+    bench_format();
+    return 0;
+}
@@ -0,0 +1,91 @@
+////////////////////////////////////////////
+// File    : bench_lookup.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Compares Type$find_member against a plain
+// strcmp scan for types of different sizes.
+//
+// Build with every file in src/ except main.c
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/rtti.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUPS 2000000
+
+static const Member *linear_find_member(const Type *type, const char *name)
+{
+    for (unsigned i = 0; i < type->member_count; ++i)
+    {
+        const Member *member = type->members[i];
+        if (strcmp(member->name, name) == 0)
+        {
+            return member;
+        }
+    }
+
+    return NULL;
+}
+
+static Type make_type(unsigned member_count, char **names)
+{
+    Member *members = calloc(member_count, sizeof(Member));
+    const Member **member_list = malloc(member_count * sizeof(const Member *));
+
+    for (unsigned i = 0; i < member_count; ++i)
+    {
+        members[i].name = names[i];
+        member_list[i] = &members[i];
+    }
+
+    Type type = { TK_COMPLEX, 0, 0, "BenchType" };
+    type.member_count = member_count;
+    type.members = member_list;
+    return type;
+}
+
+static void run(unsigned member_count)
+{
+    char **names = malloc(member_count * sizeof(char *));
+    for (unsigned i = 0; i < member_count; ++i)
+    {
+        names[i] = malloc(32);
+        sprintf(names[i], "member_name_%u", i);
+    }
+
+    Type type = make_type(member_count, names);
+
+    // Warm up, this also builds the index
+    Bench$sink = (uintptr_t)Type$find_member(&type, names[0]);
+
+    uint64_t start = Bench$now_ns();
+    for (unsigned i = 0; i < LOOKUPS; ++i)
+    {
+        Bench$sink = (uintptr_t)linear_find_member(&type, names[i % member_count]);
+    }
+    uint64_t linear_ns = Bench$now_ns() - start;
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < LOOKUPS; ++i)
+    {
+        Bench$sink = (uintptr_t)Type$find_member(&type, names[i % member_count]);
+    }
+    uint64_t hashed_ns = Bench$now_ns() - start;
+
+    printf("%4u members: linear %8.2f ns/op, hashed %6.2f ns/op\n",
+           member_count,
+           (double)linear_ns / LOOKUPS,
+           (double)hashed_ns / LOOKUPS);
+}
+
+int main(void)
+{
+    run(5);
+    run(50);
+    run(500);
+    return 0;
+}
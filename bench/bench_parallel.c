@@ -0,0 +1,135 @@
+////////////////////////////////////////////
+// File    : bench_parallel.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Measures how the parallel Vector operations scale
+// from 1 core up to every core on the machine.
+//
+// Build with every file in src/ except main.c
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/vector_par.h"
+#include "../src/job.h"
+#include "../src/thread.h"
+#include "../src/rtti.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define ELEMENTS (8u * 1024 * 1024)
+#define REPEATS 5
+
+// Enough math per element that the work isn't purely memory bound
+static void update(void *item, void *context)
+{
+    (context); // unused
+    float *value = (float *)item;
+    *value = sqrtf(*value * *value + 1.0f) * 0.5f;
+}
+
+static void square(void *result, const void *item, void *context)
+{
+    (context); // unused
+    float value = *(const float *)item;
+    *(float *)result = value * value;
+}
+
+static void add(void *accum, const void *value, void *context)
+{
+    (context); // unused
+    *(float *)accum += *(const float *)value;
+}
+
+static bool is_large(const void *item, void *context)
+{
+    (context); // unused
+    return *(const float *)item > 0.75f;
+}
+
+static double ms_per_op(uint64_t start)
+{
+    return (double)(Bench$now_ns() - start) / REPEATS / 1e6;
+}
+
+static void run(unsigned cores, Vector *data, double *baseline)
+{
+    // The calling thread helps, so one core means no workers at all
+    if (cores > 1)
+    {
+        JobSystem$start(cores - 1);
+    }
+
+    uint64_t start = Bench$now_ns();
+    for (unsigned i = 0; i < REPEATS; ++i)
+    {
+        Vector$par_for_each(data, update, NULL);
+    }
+    double each_ms = ms_per_op(start);
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < REPEATS; ++i)
+    {
+        Vector squares = Vector$par_map(data, &type_float, square, NULL);
+        Vector$free(&squares);
+    }
+    double map_ms = ms_per_op(start);
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < REPEATS; ++i)
+    {
+        float sum, zero = 0.0f;
+        Vector$par_reduce(data, &sum, &zero, add, NULL);
+        Bench$sink += (uintptr_t)sum;
+    }
+    double reduce_ms = ms_per_op(start);
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < REPEATS; ++i)
+    {
+        Vector large = Vector$par_filter(data, is_large, NULL);
+        Bench$sink += large.len;
+        Vector$free(&large);
+    }
+    double filter_ms = ms_per_op(start);
+
+    if (cores > 1)
+    {
+        JobSystem$stop();
+    }
+
+    double total = each_ms + map_ms + reduce_ms + filter_ms;
+    if (cores == 1)
+    {
+        *baseline = total;
+    }
+
+    printf("%3u cores: for_each %7.2f ms, map %7.2f ms, reduce %7.2f ms, filter %7.2f ms, speedup %.2fx\n",
+           cores, each_ms, map_ms, reduce_ms, filter_ms, *baseline / total);
+}
+
+int main(void)
+{
+    Vector data = Vector$new(&type_float);
+    Vector$reserve(&data, ELEMENTS);
+    for (unsigned i = 0; i < ELEMENTS; ++i)
+    {
+        float value = (float)(i % 1000) / 1000.0f;
+        Vector$push(&data, &value);
+    }
+
+    double baseline = 0.0;
+    unsigned max_cores = Thread$cpu_count();
+    for (unsigned cores = 1; cores <= max_cores; cores = cores < 4 ? cores + 1 : cores * 2)
+    {
+        run(cores, &data, &baseline);
+    }
+    if (max_cores > 4 && (max_cores & (max_cores - 1)))
+    {
+        run(max_cores, &data, &baseline);
+    }
+
+    Vector$free(&data);
+    return 0;
+}
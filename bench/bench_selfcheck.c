@@ -0,0 +1,801 @@
+////////////////////////////////////////////
+// File    : bench_selfcheck.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Behavior checks for the containers and file formats.
+// The benchmarks only time these, so this runs round
+// trips and edge cases against simple reference
+// implementations and checks every result.
+//
+//   bench_selfcheck
+//
+// Prints each failure and exits with 1 if there were any.
+// make check builds and runs it with bench_stress.
+//
+// Build with every file in src/ except main.c
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/arena.h"
+#include "../src/hashmap.h"
+#include "../src/helpers.h"
+#include "../src/job.h"
+#include "../src/rtti.h"
+#include "../src/serialize.h"
+#include "../src/string.h"
+#include "../src/vector.h"
+#include "../src/vector_map.h"
+#include "../src/vector_sort.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned failures;
+
+// Scratch file in the working directory, removed after each check
+#define CHECK_FILE "bench_selfcheck.tmp"
+
+#define CHECK(cond, ...) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            failures++; \
+        } \
+    } while (0)
+
+// xorshift32, so every run checks the same input
+static uint32_t check_random(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/////////////////////////////////////
+// HashMap
+
+#define MAP_KEYS 5000
+
+static void check_hashmap(void)
+{
+    HashMap map = HashMap$new(&type_int64_t, &type_int32_t);
+    for (int64_t key = 0; key < MAP_KEYS; ++key)
+    {
+        int32_t value = (int32_t)key * 3;
+        CHECK(HashMap$insert(&map, &key, &value), "insert of new key %lld returned false",
+              (long long)key);
+    }
+    CHECK(HashMap$len(&map) == MAP_KEYS, "len is %u after %u inserts",
+          (unsigned)HashMap$len(&map), MAP_KEYS);
+
+    // Inserting an existing key replaces the value
+    int64_t key = 7;
+    int32_t value = -1;
+    CHECK(!HashMap$insert(&map, &key, &value), "insert of an existing key returned true");
+    CHECK(*(int32_t *)HashMap$get(&map, &key) == -1, "insert didn't replace the value");
+    value = 21;
+    HashMap$insert(&map, &key, &value);
+
+    // Removing every even key leaves tombstones the odd keys
+    // have to be found past
+    for (key = 0; key < MAP_KEYS; key += 2)
+    {
+        CHECK(HashMap$remove(&map, &key), "remove of present key %lld returned false",
+              (long long)key);
+    }
+    key = 0;
+    CHECK(!HashMap$remove(&map, &key), "remove of a removed key returned true");
+
+    unsigned wrong = 0;
+    for (key = 0; key < MAP_KEYS; ++key)
+    {
+        int32_t *found = (int32_t *)HashMap$get(&map, &key);
+        if (key % 2)
+        {
+            wrong += !found || *found != (int32_t)key * 3;
+        }
+        else
+        {
+            wrong += found != NULL || HashMap$contains(&map, &key);
+        }
+    }
+    CHECK(!wrong, "%u keys came back wrong after removing half", wrong);
+    CHECK(HashMap$len(&map) == MAP_KEYS / 2, "len is %u after removing half",
+          (unsigned)HashMap$len(&map));
+
+    // Iteration visits every live entry exactly once
+    size_t visited = 0;
+    int64_t key_sum = 0;
+    for (size_t i = HashMap$next(&map, 0); i < map.cap; i = HashMap$next(&map, i + 1))
+    {
+        visited++;
+        key_sum += *(int64_t *)HashMap$key_at(&map, i);
+    }
+    CHECK(visited == MAP_KEYS / 2 && key_sum == (int64_t)(MAP_KEYS / 2) * (MAP_KEYS / 2),
+          "iteration visited %u entries", (unsigned)visited);
+
+    // Copies are independent
+    HashMap copy = HashMap$copy(&map);
+    key = 1;
+    HashMap$remove(&copy, &key);
+    CHECK(HashMap$contains(&map, &key) && !HashMap$contains(&copy, &key),
+          "removing from a copy changed the original");
+    HashMap$free(&copy);
+
+    // Churning with a bounded number of live keys fills the table with
+    // tombstones, which have to be reclaimed instead of growing forever
+    HashMap$clear(&map);
+    CHECK(HashMap$len(&map) == 0, "len is %u after clear", (unsigned)HashMap$len(&map));
+    size_t cap = 0;
+    for (key = 0; key < MAP_KEYS * 20; ++key)
+    {
+        value = (int32_t)key;
+        HashMap$insert(&map, &key, &value);
+        if (key >= 64)
+        {
+            int64_t old = key - 64;
+            HashMap$remove(&map, &old);
+        }
+        if (key == 1000)
+        {
+            cap = map.cap;
+        }
+    }
+    CHECK(HashMap$len(&map) == 64, "len is %u after churning", (unsigned)HashMap$len(&map));
+    CHECK(map.cap <= cap * 2, "churning grew the table from %u to %u slots",
+          (unsigned)cap, (unsigned)map.cap);
+    HashMap$free(&map);
+
+    // Keys with destructors and their own hash
+    HashMap names = HashMap$new(&type_string, &type_int32_t);
+    char text[64];
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        snprintf(text, sizeof(text), "a name long enough to leave the inline buffer %d", i);
+        String name = String$from_cstr(text);
+        HashMap$insert(&names, &name, &i);
+    }
+    wrong = 0;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        snprintf(text, sizeof(text), "a name long enough to leave the inline buffer %d", i);
+        String name = String$from_literal(text);
+        int32_t *found = (int32_t *)HashMap$get(&names, &name);
+        wrong += !found || *found != i;
+    }
+    CHECK(!wrong, "%u String keys came back wrong", wrong);
+    HashMap$free(&names);
+}
+
+/////////////////////////////////////
+// Bulk Vector operations
+
+static bool vector_equals(const Vector *vec, const int32_t *expected, size_t len)
+{
+    return vec->len == len && (!len || memcmp(vec->data, expected, len * sizeof(int32_t)) == 0);
+}
+
+static void check_vector_bulk(void)
+{
+    int32_t items[16];
+    for (int32_t i = 0; i < 16; ++i)
+    {
+        items[i] = i;
+    }
+
+    Vector vec = Vector$new(&type_int32_t);
+    Vector$push_n(&vec, items, 8);
+    Vector$push_n(&vec, items, 0);
+    CHECK(vector_equals(&vec, items, 8), "push_n didn't append the items");
+
+    int32_t inserted[] = { 0, 1, 100, 101, 2, 3, 4, 5, 6, 7 };
+    int32_t extra[] = { 100, 101 };
+    Vector$insert_range(&vec, 2, extra, 2);
+    CHECK(vector_equals(&vec, inserted, 10), "insert_range in the middle");
+
+    int32_t at_ends[] = { 100, 0, 1, 100, 101, 2, 3, 4, 5, 6, 7, 101 };
+    Vector$insert_range(&vec, 0, extra, 1);
+    Vector$insert_range(&vec, vec.len, extra + 1, 1);
+    CHECK(vector_equals(&vec, at_ends, 12), "insert_range at the front and back");
+
+    Vector$remove_range(&vec, 0, 1);
+    Vector$remove_range(&vec, vec.len - 1, 1);
+    Vector$remove_range(&vec, 2, 2);
+    Vector$remove_range(&vec, 3, 0);
+    CHECK(vector_equals(&vec, items, 8), "remove_range didn't undo the inserts");
+
+    // Items from the vector itself, while it has to grow
+    int32_t aliased[] = { 0, 1, 2, 3, 4, 5, 6, 7, 2, 3, 4, 5, 6 };
+    Vector$push_n(&vec, (int32_t *)vec.data + 2, 5);
+    CHECK(vector_equals(&vec, aliased, 13), "push_n of the vector's own items");
+    int32_t straddled[] = { 0, 1, 2, 3, 4, 3, 4, 5, 5, 6, 7, 2, 3, 4, 5, 6 };
+    Vector$insert_range(&vec, 5, (int32_t *)vec.data + 3, 3);
+    CHECK(vector_equals(&vec, straddled, 16), "insert_range of items straddling the index");
+
+    // drain moves to the end of another vector, splice swaps a range
+    Vector into = Vector$new(&type_int32_t);
+    Vector$push_n(&into, extra, 2);
+    Vector$drain(&vec, 5, 4, &into);
+    int32_t remaining[] = { 0, 1, 2, 3, 4, 6, 7, 2, 3, 4, 5, 6 };
+    int32_t drained[] = { 100, 101, 3, 4, 5, 5 };
+    CHECK(vector_equals(&vec, remaining, 12) && vector_equals(&into, drained, 6),
+          "drain didn't move the range");
+
+    Vector$splice(&vec, 1, 10, &into);
+    int32_t spliced[] = { 0, 100, 101, 3, 4, 5, 5, 6 };
+    CHECK(vector_equals(&vec, spliced, 8) && into.len == 0, "splice didn't replace the range");
+
+    // extend copies, so the source keeps its own values
+    Vector names = Vector$new(&type_string);
+    for (int i = 0; i < 3; ++i)
+    {
+        String name = String$from_cstr("a String long enough to need its own buffer");
+        Vector$push(&names, &name);
+    }
+    Vector copies = Vector$new(&type_string);
+    Vector$extend(&copies, &names);
+    Vector$extend(&copies, &copies);
+    bool equal = copies.len == 6;
+    for (size_t i = 0; equal && i < copies.len; ++i)
+    {
+        const String *copy = (const String *)copies.data + i;
+        const String *name = (const String *)names.data + i % 3;
+        equal = String$equal(*copy, *name) && String$cstr(copy) != String$cstr(name);
+    }
+    CHECK(equal, "extend didn't copy the Strings");
+    Vector$remove_range(&copies, 1, 4);
+    CHECK(copies.len == 2, "remove_range of Strings left %u", (unsigned)copies.len);
+
+    Vector$free(&copies);
+    Vector$free(&names);
+    Vector$free(&into);
+    Vector$free(&vec);
+}
+
+/////////////////////////////////////
+// Sorting
+
+// Ordered by key alone, so equal keys show whether a sort kept
+// the original order of the elements
+typedef struct SortEntry SortEntry;
+struct SortEntry
+{
+    int32_t key;
+    int32_t order;
+};
+
+static Any rtti_entry_cmp(void *obj, unsigned arg_count, Any *arguments)
+{
+    (arg_count); // unreferenced parameter
+
+    const SortEntry *lhs = (const SortEntry *)obj;
+    const SortEntry *rhs = (const SortEntry *)Any$data(&arguments[0]);
+    Any result = { &type_int32_t };
+    result.value.i32 = (lhs->key > rhs->key) - (lhs->key < rhs->key);
+    return result;
+}
+
+static Member entry_cmp_member =
+{
+    ".cmp",
+    rtti_entry_cmp,
+    1, NULL, // Args, another SortEntry
+    &type_int32_t, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static const Member *entry_members[] =
+{
+    &entry_cmp_member,
+};
+
+static Type type_sort_entry =
+{
+    TK_COMPLEX,
+    sizeof(SortEntry), // Size
+    sizeof(int32_t), // Alignment
+    "SortEntry", // Name
+    NULL, // Subtype
+    NULL, NULL, // Plain data, no constructor or destructor
+    0, NULL, // No accessible fields
+    ARRAY_SIZE(entry_members), entry_members,
+    0, NULL, // No interfaces
+    NULL, NULL, // Hashed and compared as bytes
+    TT_POD,
+};
+
+static int compare_int32(const void *lhs, const void *rhs)
+{
+    int32_t a = *(const int32_t *)lhs;
+    int32_t b = *(const int32_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+static int compare_float(const void *lhs, const void *rhs)
+{
+    float a = *(const float *)lhs;
+    float b = *(const float *)rhs;
+    return (a > b) - (a < b);
+}
+
+// Number of elements out of order, or out of their original order
+// among equal keys
+static size_t entries_unstable(const Vector *vec)
+{
+    const SortEntry *entries = (const SortEntry *)vec->data;
+    size_t wrong = 0;
+    for (size_t i = 1; i < vec->len; ++i)
+    {
+        wrong += entries[i - 1].key > entries[i].key ||
+                 (entries[i - 1].key == entries[i].key && entries[i - 1].order > entries[i].order);
+    }
+    return wrong;
+}
+
+static Vector random_entries(size_t count, uint32_t seed)
+{
+    Vector vec = Vector$new(&type_sort_entry);
+    Vector$reserve(&vec, count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Few keys, so nearly every element has equal neighbours
+        SortEntry entry = { (int32_t)(check_random(&seed) % 64) - 32, (int32_t)i };
+        Vector$push(&vec, &entry);
+    }
+    return vec;
+}
+
+static void check_sort(void)
+{
+    // Empty and single element vectors are left alone
+    Vector vec = Vector$new(&type_int32_t);
+    Vector$sort(&vec);
+    Vector$sort_stable(&vec);
+    int32_t one = 5;
+    Vector$push(&vec, &one);
+    Vector$sort(&vec);
+    CHECK(vec.len == 1 && *(int32_t *)vec.data == 5, "sorting one element changed it");
+    Vector$remove_range(&vec, 0, vec.len);
+
+    // Both sides of the radix threshold, with negatives for the sign
+    size_t sizes[] = { 15, 63, 64, 1000, 20000 };
+    uint32_t seed = 2463534242u;
+    for (size_t s = 0; s < ARRAY_SIZE(sizes); ++s)
+    {
+        size_t count = sizes[s];
+        int32_t *expected = malloc(count * sizeof(int32_t));
+        float *expected_floats = malloc(count * sizeof(float));
+        Vector floats = Vector$new(&type_float);
+        for (size_t i = 0; i < count; ++i)
+        {
+            int32_t value = (int32_t)(check_random(&seed) % 2001) - 1000;
+            float real = (float)value / 8.0f;
+            expected[i] = value;
+            expected_floats[i] = real;
+            Vector$push(&vec, &value);
+            Vector$push(&floats, &real);
+        }
+        qsort(expected, count, sizeof(int32_t), compare_int32);
+        qsort(expected_floats, count, sizeof(float), compare_float);
+
+        Vector$sort(&vec);
+        CHECK(vec.len == count && memcmp(vec.data, expected, count * sizeof(int32_t)) == 0,
+              "sort of %u int32_t differs from qsort", (unsigned)count);
+        Vector$sort(&floats);
+        CHECK(floats.len == count && memcmp(floats.data, expected_floats, count * sizeof(float)) == 0,
+              "sort of %u floats differs from qsort", (unsigned)count);
+
+        // Searches on the sorted result
+        int32_t target = expected[count / 2];
+        size_t lower = Vector$lower_bound(&vec, &target);
+        size_t found = Vector$binary_search(&vec, &target);
+        CHECK(lower <= count / 2 && expected[lower] == target && (!lower || expected[lower - 1] < target),
+              "lower_bound of %d in %u elements returned %u", target, (unsigned)count, (unsigned)lower);
+        CHECK(found != VECTOR_NPOS && expected[found] == target,
+              "binary_search missed %d in %u elements", target, (unsigned)count);
+        target = 5000;
+        CHECK(Vector$binary_search(&vec, &target) == VECTOR_NPOS &&
+              Vector$lower_bound(&vec, &target) == count,
+              "search for a value past the end of %u elements", (unsigned)count);
+
+        Vector entries = random_entries(count, seed);
+        Vector$sort_stable(&entries);
+        CHECK(entries.len == count && !entries_unstable(&entries),
+              "sort_stable of %u entries reordered equal keys", (unsigned)count);
+        Vector$free(&entries);
+
+        Vector$free(&floats);
+        Vector$remove_range(&vec, 0, vec.len);
+        free(expected_floats);
+        free(expected);
+    }
+    Vector$free(&vec);
+
+    // par_sort has to be just as stable once it splits across the workers
+    JobSystem$start(3);
+    Vector entries = random_entries(VECTOR_PAR_SORT_THRESHOLD * 2 + 7, seed);
+    Vector$par_sort(&entries);
+    size_t keys = 0;
+    for (size_t i = 0; i < entries.len; ++i)
+    {
+        keys += (size_t)((const SortEntry *)entries.data)[i].order;
+    }
+    size_t count = entries.len;
+    CHECK(count == VECTOR_PAR_SORT_THRESHOLD * 2 + 7 && keys == count * (count - 1) / 2,
+          "par_sort lost or duplicated entries");
+    CHECK(!entries_unstable(&entries), "par_sort reordered equal keys");
+    Vector$free(&entries);
+    JobSystem$stop();
+}
+
+/////////////////////////////////////
+// Serialize
+
+// Plain data, saved as raw bytes
+typedef struct CheckPoint CheckPoint;
+struct CheckPoint
+{
+    float x, y;
+};
+
+// One field of every kind a snapshot can hold
+typedef struct CheckRecord CheckRecord;
+struct CheckRecord
+{
+    String name;
+    const char *tag;
+    const char *missing;
+    int32_t id;
+    double score;
+    CheckPoint *origin;
+    CheckPoint *nowhere;
+    Vector samples; // int64_t
+    Vector points; // CheckPoint
+    Vector labels; // String
+    Vector rows; // Vector of int32_t
+};
+
+static Field point_x = { "x", &type_float, offsetof(CheckPoint, x), false };
+static Field point_y = { "y", &type_float, offsetof(CheckPoint, y), false };
+static const Field *point_fields[] = { &point_x, &point_y };
+
+static Type type_check_point =
+{
+    TK_COMPLEX,
+    sizeof(CheckPoint), // Size
+    sizeof(float), // Alignment
+    "CheckPoint", // Name
+    NULL, // Subtype
+    NULL, NULL, // Plain data, no constructor or destructor
+    ARRAY_SIZE(point_fields), point_fields,
+    0, NULL, // No members
+    0, NULL, // No interfaces
+    NULL, NULL, // Hashed and compared as bytes
+    TT_POD,
+};
+
+static Field record_name = { "name", &type_string, offsetof(CheckRecord, name), false };
+static Field record_tag = { "tag", &type_cstr, offsetof(CheckRecord, tag), false };
+static Field record_missing = { "missing", &type_cstr, offsetof(CheckRecord, missing), false };
+static Field record_id = { "id", &type_int32_t, offsetof(CheckRecord, id), false };
+static Field record_score = { "score", &type_double, offsetof(CheckRecord, score), false };
+static Field record_origin = { "origin", &type_check_point, offsetof(CheckRecord, origin), true };
+static Field record_nowhere = { "nowhere", &type_check_point, offsetof(CheckRecord, nowhere), true };
+static Field record_samples = { "samples", &type_vector, offsetof(CheckRecord, samples), false };
+static Field record_points = { "points", &type_vector, offsetof(CheckRecord, points), false };
+static Field record_labels = { "labels", &type_vector, offsetof(CheckRecord, labels), false };
+static Field record_rows = { "rows", &type_vector, offsetof(CheckRecord, rows), false };
+static const Field *record_fields[] =
+{
+    &record_name, &record_tag, &record_missing, &record_id, &record_score, &record_origin,
+    &record_nowhere, &record_samples, &record_points, &record_labels, &record_rows,
+};
+
+static Type type_check_record =
+{
+    TK_COMPLEX,
+    sizeof(CheckRecord), // Size
+    sizeof(void *), // Alignment
+    "CheckRecord", // Name
+    NULL, // Subtype
+    NULL, NULL, // Only ever saved and loaded, never constructed reflectively
+    ARRAY_SIZE(record_fields), record_fields,
+    0, NULL, // No members
+    0, NULL, // No interfaces
+};
+
+static CheckRecord check_record_new(CheckPoint *origin)
+{
+    CheckRecord record = { String$from_cstr("a record name too long for the inline buffer") };
+    record.tag = "tagged";
+    record.id = -42;
+    record.score = 1.0 / 3.0;
+    record.origin = origin;
+
+    record.samples = Vector$new(&type_int64_t);
+    record.points = Vector$new(&type_check_point);
+    record.labels = Vector$new(&type_string);
+    record.rows = Vector$new(&type_vector);
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        int64_t sample = (int64_t)i * i - 5000;
+        CheckPoint point = { (float)i, (float)-i };
+        Vector$push(&record.samples, &sample);
+        Vector$push(&record.points, &point);
+    }
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        char text[32];
+        snprintf(text, sizeof(text), "label %d", i);
+        String label = String$from_cstr(text);
+        Vector$push(&record.labels, &label);
+
+        // Rows of different lengths, the first one empty
+        Vector row = Vector$new(&type_int32_t);
+        for (int32_t j = 0; j < i * 3; ++j)
+        {
+            Vector$push(&row, &j);
+        }
+        Vector$push(&record.rows, &row);
+    }
+    return record;
+}
+
+static void check_record_free(CheckRecord *record)
+{
+    Vector$free(&record->rows);
+    Vector$free(&record->labels);
+    Vector$free(&record->points);
+    Vector$free(&record->samples);
+    String$free(&record->name);
+}
+
+static bool check_record_equal(const CheckRecord *lhs, const CheckRecord *rhs)
+{
+    bool equal = String$equal(lhs->name, rhs->name) && strcmp(lhs->tag, rhs->tag) == 0 &&
+                 !rhs->missing && lhs->id == rhs->id && lhs->score == rhs->score &&
+                 rhs->origin && rhs->origin != lhs->origin &&
+                 rhs->origin->x == lhs->origin->x && rhs->origin->y == lhs->origin->y &&
+                 !rhs->nowhere;
+    equal = equal && rhs->samples.member_type == &type_int64_t && rhs->samples.len == lhs->samples.len &&
+            memcmp(rhs->samples.data, lhs->samples.data, lhs->samples.len * sizeof(int64_t)) == 0;
+    equal = equal && rhs->points.member_type == &type_check_point && rhs->points.len == lhs->points.len &&
+            memcmp(rhs->points.data, lhs->points.data, lhs->points.len * sizeof(CheckPoint)) == 0;
+    equal = equal && rhs->labels.len == lhs->labels.len && rhs->rows.len == lhs->rows.len;
+    for (size_t i = 0; equal && i < lhs->labels.len; ++i)
+    {
+        equal = String$equal(((const String *)lhs->labels.data)[i], ((const String *)rhs->labels.data)[i]);
+    }
+    for (size_t i = 0; equal && i < lhs->rows.len; ++i)
+    {
+        const Vector *row = (const Vector *)lhs->rows.data + i;
+        const Vector *loaded = (const Vector *)rhs->rows.data + i;
+        equal = loaded->member_type == &type_int32_t && loaded->len == row->len &&
+                (!row->len || memcmp(loaded->data, row->data, row->len * sizeof(int32_t)) == 0);
+    }
+    return equal;
+}
+
+// The whole snapshot of a value, or NULL if saving failed
+static unsigned char *check_snapshot(const Type *type, const void *value, size_t *size)
+{
+    FILE *stream = tmpfile();
+    if (!stream)
+    {
+        return NULL;
+    }
+
+    unsigned char *data = NULL;
+    if (Serial$save(stream, type, value))
+    {
+        *size = (size_t)ftell(stream);
+        rewind(stream);
+        data = malloc(*size);
+        if (fread(data, 1, *size, stream) != *size)
+        {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(stream);
+    return data;
+}
+
+static void check_serialize(void)
+{
+    Serial$register(&type_check_record);
+    CHECK(Serial$find_type("CheckPoint") == &type_check_point,
+          "registering a type didn't register its field types");
+
+    CheckPoint origin = { 1.5f, -2.5f };
+    CheckRecord record = check_record_new(&origin);
+    size_t size = 0;
+    unsigned char *data = check_snapshot(&type_check_record, &record, &size);
+    CHECK(data != NULL, "saving a record failed");
+    if (!data)
+    {
+        check_record_free(&record);
+        return;
+    }
+
+    Arena arena = Arena$new(0);
+    CheckRecord loaded;
+    CHECK(Serial$load(data, size, &arena, &type_check_record, &loaded) &&
+          check_record_equal(&record, &loaded), "record didn't survive a round trip");
+    Arena$reset(&arena);
+
+    // Every truncation and a bad header have to fail cleanly
+    unsigned loaded_short = 0;
+    for (size_t len = 0; len < size; ++len)
+    {
+        loaded_short += Serial$load(data, len, &arena, &type_check_record, &loaded);
+        Arena$reset(&arena);
+    }
+    CHECK(!loaded_short, "%u truncated snapshots loaded", loaded_short);
+    data[0] ^= 0xff;
+    CHECK(!Serial$load(data, size, &arena, &type_check_record, &loaded), "bad magic loaded");
+    data[0] ^= 0xff;
+    int32_t wrong_type;
+    CHECK(!Serial$load(data, size, &arena, &type_int32_t, &wrong_type),
+          "a record loaded as an int32_t");
+    Arena$reset(&arena);
+
+    // Through a file, which load_file reads into the arena
+    CHECK(Serial$save_file(CHECK_FILE, &type_check_record, &record), "save_file failed");
+    CHECK(Serial$load_file(CHECK_FILE, &arena, &type_check_record, &loaded) &&
+          check_record_equal(&record, &loaded), "record didn't survive a round trip through a file");
+    remove(CHECK_FILE);
+    Arena$reset(&arena);
+    CHECK(!Serial$load_file(CHECK_FILE, &arena, &type_check_record, &loaded),
+          "loading a missing file succeeded");
+
+    // Complex types without fields can't be saved
+    Vector entries = Vector$new(&type_sort_entry);
+    SortEntry entry = { 1, 2 };
+    Vector$push(&entries, &entry);
+    size_t unsaved_size = 0;
+    unsigned char *unsaved = check_snapshot(&type_vector, &entries, &unsaved_size);
+    CHECK(!unsaved, "saving a vector of fieldless complex values succeeded");
+    free(unsaved);
+    Vector$free(&entries);
+
+    Arena$free(&arena);
+    free(data);
+    check_record_free(&record);
+}
+
+/////////////////////////////////////
+// Mapped vector files
+
+#define MAP_ELEMENTS 100000
+
+static long check_file_size(const char *path)
+{
+    FILE *stream = fopen(path, "rb");
+    if (!stream)
+    {
+        return -1;
+    }
+    fseek(stream, 0, SEEK_END);
+    long size = ftell(stream);
+    fclose(stream);
+    return size;
+}
+
+// Overwrites bytes of the file in place
+static void check_file_patch(const char *path, long offset, const void *bytes, size_t size)
+{
+    FILE *stream = fopen(path, "r+b");
+    if (stream)
+    {
+        fseek(stream, offset, SEEK_SET);
+        fwrite(bytes, 1, size, stream);
+        fclose(stream);
+    }
+}
+
+static bool check_mapped(const Vector *vec, const int64_t *expected, size_t len)
+{
+    return vec->member_type == &type_int64_t && vec->len == len &&
+           memcmp(vec->data, expected, len * sizeof(int64_t)) == 0;
+}
+
+static void check_vector_map(void)
+{
+    int64_t *expected = malloc((MAP_ELEMENTS + 10) * sizeof(int64_t));
+    for (size_t i = 0; i < MAP_ELEMENTS; ++i)
+    {
+        expected[i] = (int64_t)i * 7 - 3;
+    }
+
+    // Growing the file many times, then editing it in place
+    Vector vec;
+    if (!Vector$create_file(&vec, CHECK_FILE, &type_int64_t))
+    {
+        CHECK(false, "create_file failed");
+        free(expected);
+        return;
+    }
+    for (size_t i = 0; i < MAP_ELEMENTS; ++i)
+    {
+        Vector$push(&vec, &expected[i]);
+    }
+    Vector$remove_range(&vec, 10, 5);
+    Vector$insert_range(&vec, 10, expected + 10, 5);
+    CHECK(check_mapped(&vec, expected, MAP_ELEMENTS), "pushes to a mapped vector came back wrong");
+    Vector$free(&vec);
+    CHECK(check_file_size(CHECK_FILE) == VECTOR_FILE_HEADER_SIZE + MAP_ELEMENTS * (long)sizeof(int64_t),
+          "freeing didn't trim the file, it's %ld bytes", check_file_size(CHECK_FILE));
+
+    // Reopening finds the same elements, with or without the type given
+    Vector reopened = { NULL };
+    CHECK(Vector$map_file(&reopened, CHECK_FILE, &type_int64_t, false) &&
+          check_mapped(&reopened, expected, MAP_ELEMENTS), "reopened file came back wrong");
+    Vector$free(&reopened);
+    CHECK(Vector$map_file(&reopened, CHECK_FILE, NULL, false) &&
+          check_mapped(&reopened, expected, MAP_ELEMENTS), "reopening by the header's type name failed");
+    Vector$free(&reopened);
+
+    // Appending after a writable reopen, seen by another view once synced
+    CHECK(Vector$map_file(&vec, CHECK_FILE, &type_int64_t, true), "writable reopen failed");
+    for (size_t i = MAP_ELEMENTS; i < MAP_ELEMENTS + 10; ++i)
+    {
+        expected[i] = -(int64_t)i;
+        Vector$push(&vec, &expected[i]);
+    }
+    Vector$sync_file(&vec);
+    CHECK(Vector$map_file(&reopened, CHECK_FILE, &type_int64_t, false) &&
+          check_mapped(&reopened, expected, MAP_ELEMENTS + 10), "synced appends weren't in the file");
+    Vector$free(&reopened);
+    Vector$free(&vec);
+
+    // Files that don't match have to be refused
+    CHECK(!Vector$map_file(&reopened, CHECK_FILE, &type_uint64_t, false),
+          "a file of int64_t mapped as uint64_t");
+    uint64_t too_long = MAP_ELEMENTS + 11;
+    check_file_patch(CHECK_FILE, 8, &too_long, sizeof(too_long));
+    CHECK(!Vector$map_file(&reopened, CHECK_FILE, &type_int64_t, false),
+          "a header longer than the file mapped");
+    uint32_t bad_magic = 0;
+    check_file_patch(CHECK_FILE, 0, &bad_magic, sizeof(bad_magic));
+    CHECK(!Vector$map_file(&reopened, CHECK_FILE, &type_int64_t, false), "a bad magic mapped");
+
+    // Creating replaces the old file, and complex plain data maps too,
+    // found by name once it's registered
+    Serial$register(&type_check_point);
+    CHECK(Vector$create_file(&vec, CHECK_FILE, &type_check_point) && vec.len == 0,
+          "create_file didn't replace the old file");
+    CheckPoint point = { 3.0f, 4.0f };
+    Vector$push(&vec, &point);
+    Vector$free(&vec);
+    CHECK(Vector$map_file(&reopened, CHECK_FILE, NULL, false) &&
+          reopened.member_type == &type_check_point && reopened.len == 1 &&
+          ((CheckPoint *)reopened.data)->y == 4.0f, "a file of CheckPoints came back wrong");
+    Vector$free(&reopened);
+
+    remove(CHECK_FILE);
+    CHECK(!Vector$map_file(&reopened, CHECK_FILE, &type_int64_t, false), "a missing file mapped");
+    free(expected);
+}
+
+int main(void)
+{
+    uint64_t start = Bench$now_ns();
+    check_hashmap();
+    check_vector_bulk();
+    check_sort();
+    check_serialize();
+    check_vector_map();
+
+    printf("self checks in %.1f ms: %s\n", (double)(Bench$now_ns() - start) / 1e6,
+           failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,418 @@
+////////////////////////////////////////////
+// File    : bench_stress.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Self-checks for the lock-free and parallel code. The
+// other benchmarks only time these paths, so a broken
+// deque or a lost wake up would just look like odd
+// numbers. This hammers them from many threads at once
+// and checks every result.
+//
+//   bench_stress [rounds]
+//
+// Prints each failure and exits with 1 if there were any.
+// make check builds and runs it.
+//
+// Build with every file in src/ except main.c
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/job.h"
+#include "../src/thread.h"
+#include "../src/intern.h"
+#include "../src/vector_par.h"
+#include "../src/vector_sort.h"
+#include "../src/pool.h"
+#include "../src/rtti.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Jobs
+#define PRODUCERS 16
+#define CHILDREN 2048
+#define OUTSIDERS 4
+#define OUTSIDER_JOBS 4096
+#define WAKE_TRIES 64
+// A job that takes this long to start was never woken up
+#define WAKE_TIMEOUT_NS (2ull * 1000000000)
+// Stop early once it's clearly broken rather than timing out every try
+#define WAKE_MAX_LOST 3
+
+// Interning
+#define INTERN_THREADS 8
+#define INTERN_SHARED 4096
+#define INTERN_UNIQUE 512
+
+// Sorting
+#define SORT_ELEMENTS (VECTOR_PAR_SORT_THRESHOLD * 4 + 123)
+
+static unsigned failures;
+
+#define CHECK(cond, ...) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            failures++; \
+        } \
+    } while (0)
+
+// Busy waits, so it works the same everywhere
+static void idle(uint64_t ns)
+{
+    uint64_t end = Bench$now_ns() + ns;
+    while (Bench$now_ns() < end)
+    {
+        Thread$yield();
+    }
+}
+
+/////////////////////////////////////
+// Jobs
+
+// Every leaf job marks its own slot, so lost and doubled jobs both show up
+static volatile intptr_t leaf_hits[PRODUCERS * CHILDREN];
+static volatile intptr_t outsider_hits[OUTSIDERS * OUTSIDER_JOBS];
+static volatile intptr_t producers_done;
+
+static void leaf(void *data)
+{
+    Atomic$add((volatile intptr_t *)data, 1);
+}
+
+// Queues its children from a worker, so they go on that worker's deque
+// and the others have to steal them, then waits on them from the worker
+static void producer(void *data)
+{
+    intptr_t index = (intptr_t)data;
+    JobCounter children = JOB_COUNTER_INIT;
+    for (intptr_t i = 0; i < CHILDREN; ++i)
+    {
+        Job$run(leaf, (void *)&leaf_hits[index * CHILDREN + i], &children);
+    }
+    JobCounter$wait(&children);
+
+    for (intptr_t i = 0; i < CHILDREN; ++i)
+    {
+        if (Atomic$load(&leaf_hits[index * CHILDREN + i]) != 1)
+        {
+            return; // Leave producers_done short so the caller notices
+        }
+    }
+    Atomic$add(&producers_done, 1);
+}
+
+// Queues through the shared list, since it isn't a worker
+static void outsider(void *data)
+{
+    intptr_t index = (intptr_t)data;
+    JobCounter jobs = JOB_COUNTER_INIT;
+    for (intptr_t i = 0; i < OUTSIDER_JOBS; ++i)
+    {
+        Job$run(leaf, (void *)&outsider_hits[index * OUTSIDER_JOBS + i], &jobs);
+    }
+    JobCounter$wait(&jobs);
+    Pool$flush_thread();
+}
+
+static void after_leaves(void *data)
+{
+    // Every leaf has to be done before this runs
+    intptr_t *seen = (intptr_t *)data;
+    for (unsigned i = 0; i < PRODUCERS * CHILDREN; ++i)
+    {
+        *seen += Atomic$load(&leaf_hits[i]);
+    }
+}
+
+static void check_jobs(unsigned round)
+{
+    memset((void *)leaf_hits, 0, sizeof(leaf_hits));
+    memset((void *)outsider_hits, 0, sizeof(outsider_hits));
+    producers_done = 0;
+
+    // Producers on the workers and outsiders on their own threads,
+    // all queueing and stealing at the same time
+    JobCounter producers = JOB_COUNTER_INIT;
+    for (intptr_t i = 0; i < PRODUCERS; ++i)
+    {
+        Job$run(producer, (void *)i, &producers);
+    }
+
+    Thread *outsiders[OUTSIDERS];
+    for (intptr_t i = 0; i < OUTSIDERS; ++i)
+    {
+        outsiders[i] = Thread$spawn(outsider, (void *)i);
+    }
+
+    intptr_t seen = 0;
+    JobCounter after = JOB_COUNTER_INIT;
+    Job$run_after(&producers, after_leaves, &seen, &after);
+
+    JobCounter$wait(&producers);
+    JobCounter$wait(&after);
+    for (unsigned i = 0; i < OUTSIDERS; ++i)
+    {
+        Thread$join(outsiders[i]);
+    }
+
+    CHECK(producers_done == PRODUCERS, "round %u: %d of %d producers saw all their children",
+          round, (int)producers_done, PRODUCERS);
+    CHECK(seen == PRODUCERS * CHILDREN, "round %u: run_after job saw %d of %d leaves",
+          round, (int)seen, PRODUCERS * CHILDREN);
+
+    unsigned bad = 0;
+    for (unsigned i = 0; i < OUTSIDERS * OUTSIDER_JOBS; ++i)
+    {
+        bad += outsider_hits[i] != 1;
+    }
+    CHECK(!bad, "round %u: %u outsider jobs didn't run exactly once", round, bad);
+}
+
+static void check_wake(void)
+{
+    // Let the workers run out of spins and go to sleep before each job,
+    // then watch the counter without helping, so only a worker can run it
+    unsigned lost = 0, tries = 0;
+    for (; tries < WAKE_TRIES && lost < WAKE_MAX_LOST; ++tries)
+    {
+        idle(2000000);
+
+        intptr_t hits = 0;
+        JobCounter counter = JOB_COUNTER_INIT;
+        Job$run(leaf, &hits, &counter);
+
+        uint64_t start = Bench$now_ns();
+        while (Atomic$load(&counter.pending) && Bench$now_ns() - start < WAKE_TIMEOUT_NS)
+        {
+            Thread$yield();
+        }
+        lost += Atomic$load(&counter.pending) != 0;
+
+        // Run it ourselves if nobody woke up, so the counter can go away
+        JobCounter$wait(&counter);
+    }
+    CHECK(!lost, "%u of %u jobs queued to sleeping workers were never picked up",
+          lost, tries);
+}
+
+static void check_stop(unsigned workers)
+{
+    // Stop with nearly everything still queued, both in the shared list
+    // and on the deques the producers fill. Nothing may be left behind.
+    memset((void *)leaf_hits, 0, sizeof(leaf_hits));
+    producers_done = 0;
+
+    JobSystem$start(workers);
+    JobCounter producers = JOB_COUNTER_INIT;
+    for (intptr_t i = 0; i < PRODUCERS; ++i)
+    {
+        Job$run(producer, (void *)i, &producers);
+    }
+    intptr_t seen = 0;
+    JobCounter after = JOB_COUNTER_INIT;
+    Job$run_after(&producers, after_leaves, &seen, &after);
+    JobSystem$stop();
+
+    CHECK(!producers.pending && !after.pending, "stop left %d producer and %d later jobs pending",
+          (int)producers.pending, (int)after.pending);
+    CHECK(producers_done == PRODUCERS && seen == PRODUCERS * CHILDREN,
+          "stop ran %d of %d producers and %d of %d leaves", (int)producers_done, PRODUCERS,
+          (int)seen, PRODUCERS * CHILDREN);
+}
+
+/////////////////////////////////////
+// Interning
+
+typedef struct InternThread InternThread;
+struct InternThread
+{
+    unsigned index;
+    Atom shared[INTERN_SHARED];
+    Atom unique[INTERN_UNIQUE];
+};
+
+static void intern_worker(void *arg)
+{
+    InternThread *this = (InternThread *)arg;
+    char name[64];
+
+    // Everyone inserts the shared names at once, each in a different
+    // order, with their own names mixed in to keep the table growing
+    for (unsigned n = 0; n < INTERN_SHARED; ++n)
+    {
+        unsigned i = (n * 7919u + this->index * 104729u) % INTERN_SHARED;
+        snprintf(name, sizeof(name), "stress/shared/%u", i);
+        this->shared[i] = Intern$cstr(name);
+
+        if (n % (INTERN_SHARED / INTERN_UNIQUE) == 0)
+        {
+            unsigned u = n / (INTERN_SHARED / INTERN_UNIQUE);
+            snprintf(name, sizeof(name), "stress/unique/%u/%u", this->index, u);
+            this->unique[u] = Intern$cstr(name);
+        }
+    }
+}
+
+static void check_intern(void)
+{
+    static InternThread threads[INTERN_THREADS];
+    Thread *handles[INTERN_THREADS];
+    for (unsigned i = 0; i < INTERN_THREADS; ++i)
+    {
+        threads[i].index = i;
+        handles[i] = Thread$spawn(intern_worker, &threads[i]);
+    }
+    for (unsigned i = 0; i < INTERN_THREADS; ++i)
+    {
+        Thread$join(handles[i]);
+    }
+
+    char name[64];
+    unsigned split = 0, wrong = 0;
+    for (unsigned i = 0; i < INTERN_SHARED; ++i)
+    {
+        snprintf(name, sizeof(name), "stress/shared/%u", i);
+        Atom atom = threads[0].shared[i];
+        wrong += !atom || strcmp(atom, name) != 0 || Intern$len(atom) != strlen(name);
+        split += Intern$find(name) != atom;
+        for (unsigned t = 1; t < INTERN_THREADS; ++t)
+        {
+            split += threads[t].shared[i] != atom;
+        }
+    }
+    CHECK(!split, "%u shared names interned to more than one atom", split);
+    CHECK(!wrong, "%u shared atoms have the wrong characters or length", wrong);
+
+    unsigned missing = 0;
+    for (unsigned t = 0; t < INTERN_THREADS; ++t)
+    {
+        for (unsigned u = 0; u < INTERN_UNIQUE; ++u)
+        {
+            snprintf(name, sizeof(name), "stress/unique/%u/%u", t, u);
+            Atom atom = threads[t].unique[u];
+            missing += !atom || strcmp(atom, name) != 0 || Intern$find(name) != atom;
+        }
+    }
+    CHECK(!missing, "%u unique names didn't come back as themselves", missing);
+}
+
+/////////////////////////////////////
+// Parallel Vector operations
+
+static int compare_int32(const void *lhs, const void *rhs)
+{
+    int32_t a = *(const int32_t *)lhs;
+    int32_t b = *(const int32_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+static void add_int64(void *accum, const void *value, void *context)
+{
+    (context); // unused
+    *(int64_t *)accum += *(const int64_t *)value;
+}
+
+static bool is_odd(const void *item, void *context)
+{
+    (context); // unused
+    return *(const int64_t *)item & 1;
+}
+
+static void check_par_sort(unsigned round)
+{
+    // Narrow enough to have plenty of duplicates, and negatives
+    // so the radix passes have to get the sign right
+    uint32_t state = 2463534242u + round;
+    int32_t *expected = malloc(SORT_ELEMENTS * sizeof(int32_t));
+    Vector vec = Vector$new(&type_int32_t);
+    Vector$reserve(&vec, SORT_ELEMENTS);
+    for (size_t i = 0; i < SORT_ELEMENTS; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        int32_t value = (int32_t)(state % 200003) - 100000;
+        expected[i] = value;
+        Vector$push(&vec, &value);
+    }
+
+    qsort(expected, SORT_ELEMENTS, sizeof(int32_t), compare_int32);
+    Vector$par_sort(&vec);
+
+    CHECK(vec.len == SORT_ELEMENTS, "round %u: par_sort changed the length to %u",
+          round, (unsigned)vec.len);
+    size_t mismatch = VECTOR_NPOS;
+    for (size_t i = 0; i < SORT_ELEMENTS && i < vec.len; ++i)
+    {
+        if (((int32_t *)vec.data)[i] != expected[i])
+        {
+            mismatch = i;
+            break;
+        }
+    }
+    CHECK(mismatch == VECTOR_NPOS, "round %u: par_sort differs from qsort at %u",
+          round, (unsigned)mismatch);
+
+    free(expected);
+    Vector$free(&vec);
+}
+
+static void check_par_vector(void)
+{
+    Vector vec = Vector$new(&type_int64_t);
+    for (int64_t i = 0; i < VECTOR_PAR_THRESHOLD * 16; ++i)
+    {
+        Vector$push(&vec, &i);
+    }
+    int64_t count = (int64_t)vec.len;
+
+    int64_t sum, zero = 0;
+    Vector$par_reduce(&vec, &sum, &zero, add_int64, NULL);
+    CHECK(sum == count * (count - 1) / 2, "par_reduce summed to %lld", (long long)sum);
+
+    // Kept elements have to come back in their original order
+    Vector odd = Vector$par_filter(&vec, is_odd, NULL);
+    bool ordered = (int64_t)odd.len == count / 2;
+    for (size_t i = 0; ordered && i < odd.len; ++i)
+    {
+        ordered = ((int64_t *)odd.data)[i] == (int64_t)i * 2 + 1;
+    }
+    CHECK(ordered, "par_filter lost, duplicated or reordered elements");
+
+    Vector$free(&odd);
+    Vector$free(&vec);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned rounds = argc > 1 ? (unsigned)atoi(argv[1]) : 8;
+
+    // At least a few workers even on small machines, so there is always
+    // someone to steal from and someone to wake up
+    unsigned cores = Thread$cpu_count();
+    unsigned workers = cores > 4 ? cores - 1 : 4;
+    JobSystem$start(workers);
+
+    uint64_t start = Bench$now_ns();
+    for (unsigned round = 0; round < rounds; ++round)
+    {
+        check_jobs(round);
+        check_par_sort(round);
+    }
+    check_wake();
+    check_par_vector();
+    JobSystem$stop();
+    check_stop(workers);
+
+    check_intern();
+
+    printf("%u rounds on %u workers in %.1f ms: %s\n", rounds, workers,
+           (double)(Bench$now_ns() - start) / 1e6, failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
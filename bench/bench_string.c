@@ -0,0 +1,115 @@
+////////////////////////////////////////////
+// File    : bench_string.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Compares the String kernels at each SIMD level
+// against the old strcmp path, from 4 bytes to 1MB.
+//
+// Build with every file in src/ except main.c
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/string.h"
+#include "../src/string_simd.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Roughly the same number of bytes is touched at every length
+#define BYTES_PER_RUN (256u * 1024 * 1024)
+
+static String make_string(size_t len, char last)
+{
+    String str = String$new();
+    String$reserve(&str, len);
+    for (size_t i = 0; i + 1 < len; ++i)
+    {
+        String$push(&str, (char)('a' + i % 26));
+    }
+    String$push(&str, last);
+    return str;
+}
+
+static double ns_per_op(uint64_t start, unsigned ops)
+{
+    return (double)(Bench$now_ns() - start) / ops;
+}
+
+static void run(size_t len)
+{
+    unsigned ops = (unsigned)(BYTES_PER_RUN / len);
+    if (ops > 20000000)
+    {
+        ops = 20000000;
+    }
+
+    // Worst case for a compare: equal until the very last byte
+    String lhs = make_string(len, 'x');
+    String rhs = make_string(len, 'y');
+    String needle = STR("xyzzy");
+    uint64_t start;
+
+    start = Bench$now_ns();
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Bench$sink += (uintptr_t)strcmp(String$cstr(&lhs), String$cstr(&rhs));
+    }
+    printf("%8zu B  strcmp  %10.2f ns/op\n", len, ns_per_op(start, ops));
+
+    for (int level = SS_SCALAR; level <= SS_AVX2; ++level)
+    {
+        if (StringKernels$set_level((StringSimd)level) != level)
+        {
+            continue;
+        }
+        const char *name = StringKernels$get()->name;
+
+        start = Bench$now_ns();
+        for (unsigned i = 0; i < ops; ++i)
+        {
+            Bench$sink += String$equal(lhs, rhs);
+        }
+        printf("%8zu B  %-6s  %10.2f ns/op equal\n", len, name, ns_per_op(start, ops));
+
+        start = Bench$now_ns();
+        for (unsigned i = 0; i < ops; ++i)
+        {
+            Bench$sink += (uintptr_t)String$compare(lhs, rhs);
+        }
+        printf("%8zu B  %-6s  %10.2f ns/op compare\n", len, name, ns_per_op(start, ops));
+
+        start = Bench$now_ns();
+        for (unsigned i = 0; i < ops; ++i)
+        {
+            Bench$sink += (uintptr_t)String$compare_nocase(lhs, rhs);
+        }
+        printf("%8zu B  %-6s  %10.2f ns/op compare_nocase\n", len, name, ns_per_op(start, ops));
+
+        start = Bench$now_ns();
+        for (unsigned i = 0; i < ops; ++i)
+        {
+            Bench$sink += String$find(lhs, needle);
+        }
+        printf("%8zu B  %-6s  %10.2f ns/op find\n", len, name, ns_per_op(start, ops));
+
+        start = Bench$now_ns();
+        for (unsigned i = 0; i < ops; ++i)
+        {
+            Bench$sink += String$find_any(lhs, STR("XYZ!"));
+        }
+        printf("%8zu B  %-6s  %10.2f ns/op find_any\n", len, name, ns_per_op(start, ops));
+    }
+
+    String$free(&lhs);
+    String$free(&rhs);
+}
+
+int main(void)
+{
+    for (size_t len = 4; len <= 1024 * 1024; len *= 4)
+    {
+        run(len);
+    }
+    return 0;
+}
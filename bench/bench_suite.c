@@ -0,0 +1,444 @@
+////////////////////////////////////////////
+// File    : bench_suite.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+//
+// Regression benchmarks for the RTTI, String and Vector
+// hot paths. Each benchmark is timed over many samples
+// and reported as ns/op percentiles.
+//
+//   bench_suite [filter] [--json path]
+//
+// Only benchmarks whose names contain filter are run.
+// With --json the results are also written to path, or
+// to stdout if path is -.
+//
+// Build with every file in src/ except main.c. Building
+// with RTTI_PROFILE also prints the profile counters.
+////////////////////////////////////////////
+
+#include "bench.h"
+#include "../src/rtti.h"
+#include "../src/string.h"
+#include "../src/vector.h"
+#include "../src/vector_sort.h"
+#include "../src/writer.h"
+#include "../src/profile.h"
+#include "../src/sync.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Each sample runs for about this long
+#define SAMPLE_NS 1000000u
+#define SAMPLES 101
+#define MAX_RESULTS 64
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+typedef struct BenchResult BenchResult;
+typedef struct Suite Suite;
+// Runs the operation being measured ops times
+typedef void (*BenchBody)(void *context, unsigned ops);
+
+struct BenchResult
+{
+    const char *name;
+    unsigned ops_per_sample;
+    double min;
+    double p50;
+    double p90;
+    double p99;
+    double mean;
+};
+
+struct Suite
+{
+    const char *filter;
+    unsigned result_count;
+    BenchResult results[MAX_RESULTS];
+};
+
+static uint64_t time_batch(BenchBody body, void *context, unsigned ops)
+{
+    uint64_t start = Bench$now_ns();
+    body(context, ops);
+    return Bench$now_ns() - start;
+}
+
+static void Suite$run(Suite *this, const char *name, BenchBody body, void *context)
+{
+    if (this->filter && !strstr(name, this->filter))
+    {
+        return;
+    }
+
+    // Grow the batch until one sample takes long enough to time well,
+    // which doubles as the warm up
+    unsigned ops = 1;
+    while (ops < (1u << 30) && time_batch(body, context, ops) < SAMPLE_NS / 4)
+    {
+        ops *= 2;
+    }
+    ops *= 4;
+
+    Vector samples = Vector$new(&type_double);
+    Vector$reserve(&samples, SAMPLES);
+    double total = 0.0;
+    for (unsigned i = 0; i < SAMPLES; ++i)
+    {
+        double ns_per_op = (double)time_batch(body, context, ops) / ops;
+        Vector$push(&samples, &ns_per_op);
+        total += ns_per_op;
+    }
+    Vector$sort(&samples);
+
+    const double *sorted = (const double *)samples.data;
+    BenchResult result =
+    {
+        name,
+        ops,
+        sorted[0],
+        sorted[SAMPLES / 2],
+        sorted[SAMPLES * 90 / 100],
+        sorted[SAMPLES * 99 / 100],
+        total / SAMPLES,
+    };
+    Vector$free(&samples);
+
+    printf("%-26s %10.2f ns/op  p90 %10.2f  p99 %10.2f  min %10.2f\n",
+           name, result.p50, result.p90, result.p99, result.min);
+    fflush(stdout);
+
+    if (this->result_count < MAX_RESULTS)
+    {
+        this->results[this->result_count++] = result;
+    }
+}
+
+static void Suite$write_json(const Suite *this, Writer *writer)
+{
+    static const char *stats[] = { "min", "p50", "p90", "p99", "mean" };
+
+    Writer$cstr(writer, "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n");
+    for (unsigned i = 0; i < this->result_count; ++i)
+    {
+        const BenchResult *result = &this->results[i];
+        const double values[] = { result->min, result->p50, result->p90, result->p99, result->mean };
+
+        Writer$cstr(writer, "    { \"name\": \"");
+        Writer$cstr(writer, result->name);
+        Writer$cstr(writer, "\", \"ops_per_sample\": ");
+        Writer$uint(writer, result->ops_per_sample);
+        Writer$cstr(writer, ", \"samples\": ");
+        Writer$uint(writer, SAMPLES);
+        for (unsigned s = 0; s < sizeof(stats) / sizeof(stats[0]); ++s)
+        {
+            Writer$cstr(writer, ", \"");
+            Writer$cstr(writer, stats[s]);
+            Writer$cstr(writer, "\": ");
+            Writer$double(writer, values[s]);
+        }
+        Writer$cstr(writer, i + 1 < this->result_count ? " },\n" : " }\n");
+    }
+    Writer$cstr(writer, "  ]\n}\n");
+}
+
+/////////////////////////////////////
+// RTTI
+
+// Bigger than ANY_INLINE_SIZE, so Anys holding one are boxed
+typedef struct Boxed
+{
+    double values[8];
+} Boxed;
+
+static Type type_boxed =
+{
+    TK_COMPLEX,
+    sizeof(Boxed),
+    sizeof(double),
+    "Boxed",
+    NULL,
+    NULL, NULL, // Plain data needs no constructor or destructor
+    0, NULL,
+    0, NULL,
+    0, NULL,
+    NULL, NULL,
+    TT_POD,
+};
+
+static void body_any_invoke(void *context, unsigned ops)
+{
+    Any *str = (Any *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Bench$sink += (uintptr_t)Any$invoke_in_place(str, "cstr", 0, NULL).value.cstr;
+    }
+}
+
+static void body_any_invoke_cached(void *context, unsigned ops)
+{
+    static THREAD_LOCAL InvokeCache cache = INVOKE_CACHE("cstr");
+    Any *str = (Any *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Bench$sink += (uintptr_t)Any$invoke_cached(str, &cache, 0, NULL).value.cstr;
+    }
+}
+
+static void body_find_member(void *context, unsigned ops)
+{
+    (context); // unused
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Bench$sink += (uintptr_t)Type$find_member(&type_string, "prepend");
+    }
+}
+
+static void body_any_box(void *context, unsigned ops)
+{
+    Boxed *value = (Boxed *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Any boxed = Any$from_complex(&type_boxed, value);
+        Bench$sink += (uintptr_t)Any$data(&boxed);
+        Any$free(&boxed);
+    }
+}
+
+static void bench_rtti(Suite *suite)
+{
+    Any str = Any$make_default(&type_string);
+    Boxed boxed = { { 1.0 } };
+
+    Suite$run(suite, "rtti/any_invoke", body_any_invoke, &str);
+    Suite$run(suite, "rtti/any_invoke_cached", body_any_invoke_cached, &str);
+    Suite$run(suite, "rtti/find_member", body_find_member, NULL);
+    Suite$run(suite, "rtti/any_from_complex_free", body_any_box, &boxed);
+
+    Any$free(&str);
+}
+
+/////////////////////////////////////
+// String
+
+static void body_string_append(void *context, unsigned ops)
+{
+    String *str = (String *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        // Start over now and then so the string stays a realistic size
+        if (i % 1024 == 0)
+        {
+            String$free(str);
+        }
+        String$append(str, STR("hello, "));
+    }
+}
+
+static void body_string_prepend(void *context, unsigned ops)
+{
+    String *str = (String *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        if (i % 128 == 0)
+        {
+            String$free(str);
+        }
+        String$prepend(str, STR("hello, "));
+    }
+}
+
+static void body_string_compare(void *context, unsigned ops)
+{
+    const String *pair = (const String *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Bench$sink += (uintptr_t)String$compare(pair[0], pair[1]);
+    }
+}
+
+static void bench_string(Suite *suite)
+{
+    String str = String$new();
+    Suite$run(suite, "string/append", body_string_append, &str);
+    Suite$run(suite, "string/prepend", body_string_prepend, &str);
+    String$free(&str);
+
+    // Equal until the last character, the worst case
+    String pair[2] =
+    {
+        String$from_cstr("the quick brown fox jumps over the lazy dog, again and again!x"),
+        String$from_cstr("the quick brown fox jumps over the lazy dog, again and again!y"),
+    };
+    Suite$run(suite, "string/compare", body_string_compare, pair);
+    String$free(&pair[0]);
+    String$free(&pair[1]);
+}
+
+/////////////////////////////////////
+// Vector
+
+typedef struct PrintContext
+{
+    const Vector *vec;
+    FILE *stream;
+} PrintContext;
+
+static void body_vector_push(void *context, unsigned ops)
+{
+    Vector *vec = (Vector *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        if (i % 4096 == 0)
+        {
+            Vector$free(vec);
+        }
+        int32_t value = (int32_t)i;
+        Vector$push(vec, &value);
+    }
+}
+
+static void body_vector_copy_free(void *context, unsigned ops)
+{
+    const Vector *vec = (const Vector *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Vector copy = Vector$copy(vec);
+        Bench$sink += copy.len;
+        Vector$free(&copy);
+    }
+}
+
+static void body_vector_print(void *context, unsigned ops)
+{
+    const PrintContext *print = (const PrintContext *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Vector$print(print->vec, print->stream);
+    }
+}
+
+typedef struct InvokeContext
+{
+    Vector *vec;
+    Any *results;
+} InvokeContext;
+
+static void body_vector_invoke_loop(void *context, unsigned ops)
+{
+    const InvokeContext *invoke = (const InvokeContext *)context;
+    const Member *len = Type$find_member(invoke->vec->member_type, "len");
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        String *items = (String *)invoke->vec->data;
+        for (size_t e = 0; e < invoke->vec->len; ++e)
+        {
+            Any str = Any$ref_complex(&type_string, &items[e]);
+            invoke->results[e] = Any$invoke_member(&str, len, 0, NULL);
+        }
+    }
+}
+
+static void body_vector_invoke_each(void *context, unsigned ops)
+{
+    const InvokeContext *invoke = (const InvokeContext *)context;
+    for (unsigned i = 0; i < ops; ++i)
+    {
+        Vector$invoke_each(invoke->vec, "len", 0, NULL, invoke->results);
+    }
+}
+
+static void bench_vector(Suite *suite)
+{
+    Vector pushed = Vector$new(&type_int32_t);
+    Suite$run(suite, "vector/push", body_vector_push, &pushed);
+    Vector$free(&pushed);
+
+    Vector ints = Vector$new(&type_int32_t);
+    Vector strings = Vector$new(&type_string);
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        int32_t value = i * 7919 - 500000;
+        Vector$push(&ints, &value);
+
+        String str = String$new();
+        String$append_int(&str, value);
+        String$append(&str, STR(" is a string long enough for the heap"));
+        Vector$push(&strings, &str);
+    }
+
+    Suite$run(suite, "vector/copy_free_int32_1k", body_vector_copy_free, &ints);
+    Suite$run(suite, "vector/copy_free_string_1k", body_vector_copy_free, &strings);
+
+    Any *results = (Any *)calloc(strings.len, sizeof(Any));
+    InvokeContext invoke = { &strings, results };
+    Suite$run(suite, "vector/invoke_loop_len_1k", body_vector_invoke_loop, &invoke);
+    Suite$run(suite, "vector/invoke_each_len_1k", body_vector_invoke_each, &invoke);
+    free(results);
+
+    FILE *stream = fopen(NULL_DEVICE, "w");
+    if (stream)
+    {
+        PrintContext print = { &ints, stream };
+        Suite$run(suite, "vector/print_int32_1k", body_vector_print, &print);
+        print.vec = &strings;
+        Suite$run(suite, "vector/print_string_1k", body_vector_print, &print);
+        fclose(stream);
+    }
+
+    Vector$free(&strings);
+    Vector$free(&ints);
+}
+
+int main(int argc, char **argv)
+{
+    static Suite suite;
+    const char *json_path = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else
+        {
+            suite.filter = argv[i];
+        }
+    }
+
+    bench_rtti(&suite);
+    bench_string(&suite);
+    bench_vector(&suite);
+
+    if (Profile$enabled())
+    {
+        printf("\n");
+        Profile$report(stdout);
+    }
+
+    if (json_path)
+    {
+        bool to_stdout = strcmp(json_path, "-") == 0;
+        FILE *stream = to_stdout ? stdout : fopen(json_path, "w");
+        if (!stream)
+        {
+            fprintf(stderr, "Couldn't open %s\n", json_path);
+            return 1;
+        }
+
+        Writer writer = Writer$to_file(stream, NULL, 0);
+        Suite$write_json(&suite, &writer);
+        Writer$close(&writer);
+        if (!to_stdout)
+        {
+            fclose(stream);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+////////////////////////////////////////////
+// File    : allocator.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "allocator.h"
+#include "arena.h"
+#include "sync.h"
+#include <stdlib.h>
+#include <assert.h>
+
+static Allocator *volatile allocator_global;
+static THREAD_LOCAL Allocator *allocator_thread;
+
+/////////////////////////////////////
+// Heap
+
+static void *heap_alloc(Allocator *this, size_t size, size_t alignment)
+{
+    (this); // unused
+    (alignment); // unused
+    return malloc(size);
+}
+
+static void *heap_realloc(Allocator *this, void *ptr, size_t old_size,
+                          size_t new_size, size_t alignment)
+{
+    (this); // unused
+    (old_size); // unused
+    (alignment); // unused
+    return realloc(ptr, new_size);
+}
+
+static void heap_free(Allocator *this, void *ptr, size_t size)
+{
+    (this); // unused
+    (size); // unused
+    free(ptr);
+}
+
+Allocator Allocator$heap =
+{
+    "heap",
+    heap_alloc,
+    heap_realloc,
+    heap_free,
+};
+
+/////////////////////////////////////
+// Selection
+
+Allocator *Allocator$current(void)
+{
+    Arena *arena = Arena$active();
+    if (arena)
+    {
+        return &arena->allocator;
+    }
+
+    if (allocator_thread)
+    {
+        return allocator_thread;
+    }
+
+    Allocator *global = (Allocator *)Atomic$load_ptr((void *volatile *)&allocator_global);
+    return global ? global : &Allocator$heap;
+}
+
+Allocator *Allocator$set_global(Allocator *allocator)
+{
+    Allocator *previous;
+    do
+    {
+        previous = (Allocator *)Atomic$load_ptr((void *volatile *)&allocator_global);
+    } while (!Atomic$cas_ptr((void *volatile *)&allocator_global, previous, allocator));
+    return previous;
+}
+
+Allocator *Allocator$set_thread(Allocator *allocator)
+{
+    Allocator *previous = allocator_thread;
+    allocator_thread = allocator;
+    return previous;
+}
+
+/////////////////////////////////////
+// Calls
+
+void *Allocator$alloc(Allocator *this, size_t size, size_t alignment)
+{
+    if (!this)
+    {
+        this = &Allocator$heap;
+    }
+
+    void *ptr = this->alloc(this, size, alignment);
+    assert(ptr && "Uh oh, failed to allocate memory!");
+    return ptr;
+}
+
+void *Allocator$realloc(Allocator *this, void *ptr, size_t old_size,
+                        size_t new_size, size_t alignment)
+{
+    if (!this)
+    {
+        this = &Allocator$heap;
+    }
+
+    if (!ptr)
+    {
+        return Allocator$alloc(this, new_size, alignment);
+    }
+
+    void *result = this->realloc(this, ptr, old_size, new_size, alignment);
+    assert(result && "Uh oh, failed to allocate memory!");
+    return result;
+}
+
+void Allocator$free(Allocator *this, void *ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    if (!this)
+    {
+        this = &Allocator$heap;
+    }
+    this->free(this, ptr, size);
+}
+
+const char *Allocator$name(const Allocator *this)
+{
+    if (!this)
+    {
+        this = &Allocator$heap;
+    }
+    return this->name ? this->name : "?";
+}
+
+/////////////////////////////////////
+// Tracking
+
+static void tracking_add(TrackingAllocator *this, intptr_t delta)
+{
+    intptr_t live = Atomic$add(&this->live_bytes, delta);
+    Atomic$max(&this->peak_bytes, live);
+}
+
+static void *tracking_alloc(Allocator *allocator, size_t size, size_t alignment)
+{
+    TrackingAllocator *this = (TrackingAllocator *)allocator;
+    void *ptr = this->parent->alloc(this->parent, size, alignment);
+    if (ptr)
+    {
+        Atomic$add(&this->allocations, 1);
+        tracking_add(this, (intptr_t)size);
+    }
+    return ptr;
+}
+
+static void *tracking_realloc(Allocator *allocator, void *ptr, size_t old_size,
+                              size_t new_size, size_t alignment)
+{
+    TrackingAllocator *this = (TrackingAllocator *)allocator;
+    void *result = this->parent->realloc(this->parent, ptr, old_size, new_size, alignment);
+    if (result)
+    {
+        tracking_add(this, (intptr_t)new_size - (intptr_t)old_size);
+    }
+    return result;
+}
+
+static void tracking_free(Allocator *allocator, void *ptr, size_t size)
+{
+    TrackingAllocator *this = (TrackingAllocator *)allocator;
+    this->parent->free(this->parent, ptr, size);
+    Atomic$add(&this->live_bytes, -(intptr_t)size);
+}
+
+TrackingAllocator TrackingAllocator$new(const char *name, Allocator *parent)
+{
+    TrackingAllocator tracking =
+    {
+        {
+            name,
+            tracking_alloc,
+            tracking_realloc,
+            tracking_free,
+        },
+        parent ? parent : &Allocator$heap,
+    };
+    return tracking;
+}
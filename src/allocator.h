@@ -0,0 +1,57 @@
+////////////////////////////////////////////
+// File    : allocator.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct Allocator Allocator;
+typedef struct TrackingAllocator TrackingAllocator;
+
+// malloc, realloc and free. Alignment is whatever malloc guarantees.
+extern Allocator Allocator$heap;
+
+// What new Strings, Vectors and boxed Anys allocate from on this thread:
+// the active arena scope if there is one, then the thread's allocator,
+// then the global one, which starts out as Allocator$heap.
+Allocator *Allocator$current(void);
+// Both return the previous setting. NULL restores the default.
+Allocator *Allocator$set_global(Allocator *allocator);
+Allocator *Allocator$set_thread(Allocator *allocator);
+
+// NULL stands for Allocator$heap, so zeroed containers keep working.
+// Running out of memory asserts, like everywhere else.
+void *Allocator$alloc(Allocator *this, size_t size, size_t alignment);
+void *Allocator$realloc(Allocator *this, void *ptr, size_t old_size,
+                        size_t new_size, size_t alignment);
+void  Allocator$free(Allocator *this, void *ptr, size_t size);
+const char *Allocator$name(const Allocator *this);
+
+// Forwards to parent, NULL for the heap, counting what passes through
+TrackingAllocator TrackingAllocator$new(const char *name, Allocator *parent);
+
+struct Allocator
+{
+    const char *name; // For stats and reports
+
+    // ptr is never NULL for realloc and free, and sizes are the ones
+    // the block was last allocated with
+    void *(*alloc)(Allocator *this, size_t size, size_t alignment);
+    void *(*realloc)(Allocator *this, void *ptr, size_t old_size,
+                     size_t new_size, size_t alignment);
+    void (*free)(Allocator *this, void *ptr, size_t size);
+};
+
+struct TrackingAllocator
+{
+    Allocator allocator; // Pass &tracking.allocator to containers
+    Allocator *parent;
+
+    volatile intptr_t allocations; // Calls to alloc
+    volatile intptr_t live_bytes;
+    volatile intptr_t peak_bytes;
+};
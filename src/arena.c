@@ -0,0 +1,274 @@
+////////////////////////////////////////////
+// File    : arena.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "arena.h"
+#include "rtti.h"
+#include "sync.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#define ARENA_DEFAULT_CHUNK (64 * 1024)
+// Alignment of chunk data and finalizer records
+#define ARENA_ALIGNMENT 16
+
+struct ArenaChunk
+{
+    ArenaChunk *prev;
+    size_t size;
+    size_t used;
+    size_t padding; // Rounds the header up to ARENA_ALIGNMENT
+};
+
+struct ArenaFinalizer
+{
+    ArenaFinalizer *next;
+    const Type *type; // NULL once released
+    void *value;
+};
+
+static THREAD_LOCAL Arena *arena_active;
+
+static char *ArenaChunk$data(ArenaChunk *this)
+{
+    return (char *)(this + 1);
+}
+
+static size_t Arena$align(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+// Offset of the first address past used with the given alignment. The
+// address is what gets aligned, chunk data is only ARENA_ALIGNMENT aligned.
+static size_t ArenaChunk$aligned_used(ArenaChunk *this, size_t alignment)
+{
+    uintptr_t data = (uintptr_t)ArenaChunk$data(this);
+    return (size_t)(Arena$align(data + this->used, alignment) - data);
+}
+
+static bool Arena$needs_destroy(const Type *type)
+{
+    return type->kind == TK_COMPLEX && type->destructor &&
+           !Type$has_traits(type, TT_TRIVIAL_DESTROY);
+}
+
+static Arena *Arena$from_allocator(Allocator *allocator)
+{
+    return (Arena *)((char *)allocator - offsetof(Arena, allocator));
+}
+
+static void *arena_alloc(Allocator *allocator, size_t size, size_t alignment)
+{
+    return Arena$alloc(Arena$from_allocator(allocator), size, alignment);
+}
+
+static void *arena_realloc(Allocator *allocator, void *ptr, size_t old_size,
+                           size_t new_size, size_t alignment)
+{
+    return Arena$realloc(Arena$from_allocator(allocator), ptr, old_size, new_size, alignment);
+}
+
+static void arena_free(Allocator *allocator, void *ptr, size_t size)
+{
+    // Released with the arena
+    (allocator); // unused
+    (ptr); // unused
+    (size); // unused
+}
+
+Arena Arena$new(size_t chunk_size)
+{
+    Arena arena = { NULL };
+    arena.chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK;
+    arena.allocator.name = "arena";
+    arena.allocator.alloc = arena_alloc;
+    arena.allocator.realloc = arena_realloc;
+    arena.allocator.free = arena_free;
+    return arena;
+}
+
+static void Arena$free_chunks(ArenaChunk *chunk)
+{
+    while (chunk)
+    {
+        ArenaChunk *prev = chunk->prev;
+        free(chunk);
+        chunk = prev;
+    }
+}
+
+void Arena$free(Arena *this)
+{
+    Arena$reset(this);
+    Arena$free_chunks(this->chunk);
+    Arena$free_chunks(this->spare);
+    this->chunk = NULL;
+    this->spare = NULL;
+}
+
+static ArenaChunk *Arena$new_chunk(Arena *this, size_t minimum)
+{
+    // Reuse a spare if it's big enough
+    if (this->spare && this->spare->size >= minimum)
+    {
+        ArenaChunk *chunk = this->spare;
+        this->spare = chunk->prev;
+        chunk->used = 0;
+        return chunk;
+    }
+
+    size_t size = this->chunk_size;
+    if (size < minimum)
+    {
+        size = minimum;
+    }
+
+    ArenaChunk *chunk = malloc(sizeof(ArenaChunk) + size);
+    assert(chunk && "Uh oh, failed to allocate memory!");
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+void *Arena$alloc(Arena *this, size_t size, size_t alignment)
+{
+    ArenaChunk *chunk = this->chunk;
+    if (chunk)
+    {
+        size_t offset = ArenaChunk$aligned_used(chunk, alignment);
+        if (offset + size <= chunk->size)
+        {
+            chunk->used = offset + size;
+            return ArenaChunk$data(chunk) + offset;
+        }
+    }
+
+    // Chunk data is already aligned, so the worst case
+    // only needs padding for alignments past that
+    size_t minimum = size + (alignment > ARENA_ALIGNMENT ? alignment : 0);
+    ArenaChunk *fresh = Arena$new_chunk(this, minimum);
+    fresh->prev = chunk;
+    this->chunk = fresh;
+
+    size_t offset = ArenaChunk$aligned_used(fresh, alignment);
+    fresh->used = offset + size;
+    return ArenaChunk$data(fresh) + offset;
+}
+
+void *Arena$realloc(Arena *this, void *ptr, size_t old_size, size_t new_size, size_t alignment)
+{
+    if (!ptr)
+    {
+        return Arena$alloc(this, new_size, alignment);
+    }
+
+    // The last allocation can just grow into the rest of the chunk
+    ArenaChunk *chunk = this->chunk;
+    if (chunk && (char *)ptr + old_size == ArenaChunk$data(chunk) + chunk->used)
+    {
+        size_t offset = (char *)ptr - ArenaChunk$data(chunk);
+        if (offset + new_size <= chunk->size)
+        {
+            chunk->used = offset + new_size;
+            return ptr;
+        }
+    }
+
+    void *moved = Arena$alloc(this, new_size, alignment);
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    return moved;
+}
+
+static void Arena$rewind(Arena *this, ArenaChunk *chunk, size_t used, ArenaFinalizer *finalizers)
+{
+    // Destroy newest first, in case later values refer to earlier ones
+    while (this->finalizers != finalizers)
+    {
+        ArenaFinalizer *finalizer = this->finalizers;
+        this->finalizers = finalizer->next;
+        if (finalizer->type)
+        {
+            Member$invoke(finalizer->type->destructor, finalizer->value, 0, NULL);
+        }
+    }
+
+    // Keep the released chunks around, the next frame will want them
+    while (this->chunk != chunk)
+    {
+        ArenaChunk *released = this->chunk;
+        this->chunk = released->prev;
+        released->prev = this->spare;
+        this->spare = released;
+    }
+
+    if (chunk)
+    {
+        chunk->used = used;
+    }
+}
+
+void Arena$reset(Arena *this)
+{
+    Arena$rewind(this, NULL, 0, NULL);
+}
+
+void *Arena$alloc_object(Arena *this, const Type *type)
+{
+    size_t alignment = type->alignment > ARENA_ALIGNMENT ? type->alignment : ARENA_ALIGNMENT;
+    if (!Arena$needs_destroy(type))
+    {
+        return Arena$alloc(this, type->size, alignment);
+    }
+
+    // The finalizer sits right in front of the value so
+    // Arena$release_object can find it again
+    size_t header = Arena$align(sizeof(ArenaFinalizer), alignment);
+    char *block = Arena$alloc(this, header + type->size, alignment);
+    ArenaFinalizer *finalizer = (ArenaFinalizer *)(block + header) - 1;
+
+    finalizer->type = type;
+    finalizer->value = block + header;
+    finalizer->next = this->finalizers;
+    this->finalizers = finalizer;
+    return finalizer->value;
+}
+
+void Arena$release_object(const Type *type, void *value)
+{
+    if (Arena$needs_destroy(type))
+    {
+        ArenaFinalizer *finalizer = (ArenaFinalizer *)value - 1;
+        finalizer->type = NULL;
+    }
+}
+
+ArenaScope Arena$push_scope(Arena *this)
+{
+    ArenaScope scope;
+    scope.arena = this;
+    scope.previous = arena_active;
+    scope.chunk = this->chunk;
+    scope.used = this->chunk ? this->chunk->used : 0;
+    scope.finalizers = this->finalizers;
+
+    arena_active = this;
+    return scope;
+}
+
+void Arena$pop_scope(ArenaScope *scope)
+{
+    assert(arena_active == scope->arena && "Arena scopes must be popped in order");
+    Arena$rewind(scope->arena, scope->chunk, scope->used, scope->finalizers);
+    arena_active = scope->previous;
+}
+
+Arena *Arena$active(void)
+{
+    return arena_active;
+}
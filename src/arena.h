@@ -0,0 +1,61 @@
+////////////////////////////////////////////
+// File    : arena.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "allocator.h"
+#include <stddef.h>
+
+struct Type;
+
+typedef struct Arena Arena;
+typedef struct ArenaChunk ArenaChunk;
+typedef struct ArenaFinalizer ArenaFinalizer;
+typedef struct ArenaScope ArenaScope;
+
+// chunk_size of 0 picks a sensible default
+Arena Arena$new(size_t chunk_size);
+void  Arena$free(Arena *this);
+
+void *Arena$alloc(Arena *this, size_t size, size_t alignment);
+// Grows in place when ptr was the last allocation, otherwise copies
+void *Arena$realloc(Arena *this, void *ptr, size_t old_size, size_t new_size, size_t alignment);
+// Runs pending destructors and releases everything at once
+void  Arena$reset(Arena *this);
+
+// Storage for one value of type. If the type has a destructor it will be
+// run when the arena is reset, unless the value is released first.
+void *Arena$alloc_object(Arena *this, const struct Type *type);
+// The value was moved somewhere else, so don't destroy it on reset
+void  Arena$release_object(const struct Type *type, void *value);
+
+// While a scope is active on a thread, String, Vector and boxed Any
+// construction on that thread allocates from its arena. Popping the
+// scope destroys and releases everything allocated since it was pushed.
+ArenaScope Arena$push_scope(Arena *this);
+void       Arena$pop_scope(ArenaScope *scope);
+// The arena of the innermost scope on this thread, or NULL
+Arena     *Arena$active(void);
+
+struct Arena
+{
+    ArenaChunk *chunk; // Chunk being allocated from, linked to older ones
+    ArenaChunk *spare; // Released chunks kept around for reuse
+    ArenaFinalizer *finalizers; // Pending destructors, newest first
+    size_t chunk_size;
+    // Lets the arena back any container that takes an Allocator.
+    // Freeing through it does nothing, memory comes back on reset.
+    Allocator allocator;
+};
+
+struct ArenaScope
+{
+    Arena *arena;
+    Arena *previous;
+    ArenaChunk *chunk;
+    size_t used;
+    ArenaFinalizer *finalizers;
+};
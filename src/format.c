@@ -0,0 +1,455 @@
+////////////////////////////////////////////
+// File    : format.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "format.h"
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/////////////////////////////////////
+// Integers
+
+static const char format_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char format_hex_digits[17] = "0123456789abcdef";
+
+unsigned Format$digit_count(uint64_t value)
+{
+    unsigned count = 1;
+    while (value >= 10000)
+    {
+        value /= 10000;
+        count += 4;
+    }
+    return count + (value >= 10) + (value >= 100) + (value >= 1000);
+}
+
+size_t Format$uint(char *buffer, uint64_t value)
+{
+    // Digits are written back to front, two at a time
+    unsigned len = Format$digit_count(value);
+    char *end = buffer + len;
+    while (value >= 100)
+    {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--end = format_digit_pairs[pair + 1];
+        *--end = format_digit_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        unsigned pair = (unsigned)value * 2;
+        *--end = format_digit_pairs[pair + 1];
+        *--end = format_digit_pairs[pair];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+    return len;
+}
+
+size_t Format$int(char *buffer, int64_t value)
+{
+    if (value < 0)
+    {
+        // Negate as unsigned so INT64_MIN works
+        buffer[0] = '-';
+        return 1 + Format$uint(buffer + 1, 0 - (uint64_t)value);
+    }
+    return Format$uint(buffer, (uint64_t)value);
+}
+
+unsigned Format$hex_digit_count(uint64_t value)
+{
+    unsigned len = 1;
+    while (len < 16 && (value >> (len * 4)))
+    {
+        ++len;
+    }
+    return len;
+}
+
+size_t Format$hex(char *buffer, uint64_t value)
+{
+    unsigned len = Format$hex_digit_count(value);
+    for (unsigned i = len; i-- > 0;)
+    {
+        buffer[i] = format_hex_digits[value & 0xF];
+        value >>= 4;
+    }
+    return len;
+}
+
+/////////////////////////////////////
+// Floating point
+//
+// Grisu2 from Florian Loitsch's "Printing Floating-Point Numbers Quickly
+// and Accurately with Integers". The digits always read back as the same
+// value, and are the shortest such digits for nearly every input.
+
+typedef struct DiyFp DiyFp;
+
+// f * 2^e
+struct DiyFp
+{
+    uint64_t f;
+    int e;
+};
+
+// 10^k for k = -348, -340, ..., 340, normalized to 64 bits
+static const uint64_t format_cached_f[87] =
+{
+    0xFA8FD5A0081C0288ull, 0xBAAEE17FA23EBF76ull, 0x8B16FB203055AC76ull,
+    0xCF42894A5DCE35EAull, 0x9A6BB0AA55653B2Dull, 0xE61ACF033D1A45DFull,
+    0xAB70FE17C79AC6CAull, 0xFF77B1FCBEBCDC4Full, 0xBE5691EF416BD60Cull,
+    0x8DD01FAD907FFC3Cull, 0xD3515C2831559A83ull, 0x9D71AC8FADA6C9B5ull,
+    0xEA9C227723EE8BCBull, 0xAECC49914078536Dull, 0x823C12795DB6CE57ull,
+    0xC21094364DFB5637ull, 0x9096EA6F3848984Full, 0xD77485CB25823AC7ull,
+    0xA086CFCD97BF97F4ull, 0xEF340A98172AACE5ull, 0xB23867FB2A35B28Eull,
+    0x84C8D4DFD2C63F3Bull, 0xC5DD44271AD3CDBAull, 0x936B9FCEBB25C996ull,
+    0xDBAC6C247D62A584ull, 0xA3AB66580D5FDAF6ull, 0xF3E2F893DEC3F126ull,
+    0xB5B5ADA8AAFF80B8ull, 0x87625F056C7C4A8Bull, 0xC9BCFF6034C13053ull,
+    0x964E858C91BA2655ull, 0xDFF9772470297EBDull, 0xA6DFBD9FB8E5B88Full,
+    0xF8A95FCF88747D94ull, 0xB94470938FA89BCFull, 0x8A08F0F8BF0F156Bull,
+    0xCDB02555653131B6ull, 0x993FE2C6D07B7FACull, 0xE45C10C42A2B3B06ull,
+    0xAA242499697392D3ull, 0xFD87B5F28300CA0Eull, 0xBCE5086492111AEBull,
+    0x8CBCCC096F5088CCull, 0xD1B71758E219652Cull, 0x9C40000000000000ull,
+    0xE8D4A51000000000ull, 0xAD78EBC5AC620000ull, 0x813F3978F8940984ull,
+    0xC097CE7BC90715B3ull, 0x8F7E32CE7BEA5C70ull, 0xD5D238A4ABE98068ull,
+    0x9F4F2726179A2245ull, 0xED63A231D4C4FB27ull, 0xB0DE65388CC8ADA8ull,
+    0x83C7088E1AAB65DBull, 0xC45D1DF942711D9Aull, 0x924D692CA61BE758ull,
+    0xDA01EE641A708DEAull, 0xA26DA3999AEF774Aull, 0xF209787BB47D6B85ull,
+    0xB454E4A179DD1877ull, 0x865B86925B9BC5C2ull, 0xC83553C5C8965D3Dull,
+    0x952AB45CFA97A0B3ull, 0xDE469FBD99A05FE3ull, 0xA59BC234DB398C25ull,
+    0xF6C69A72A3989F5Cull, 0xB7DCBF5354E9BECEull, 0x88FCF317F22241E2ull,
+    0xCC20CE9BD35C78A5ull, 0x98165AF37B2153DFull, 0xE2A0B5DC971F303Aull,
+    0xA8D9D1535CE3B396ull, 0xFB9B7CD9A4A7443Cull, 0xBB764C4CA7A44410ull,
+    0x8BAB8EEFB6409C1Aull, 0xD01FEF10A657842Cull, 0x9B10A4E5E9913129ull,
+    0xE7109BFBA19C0C9Dull, 0xAC2820D9623BF429ull, 0x80444B5E7AA7CF85ull,
+    0xBF21E44003ACDD2Dull, 0x8E679C2F5E44FF8Full, 0xD433179D9C8CB841ull,
+    0x9E19DB92B4E31BA9ull, 0xEB96BF6EBADF77D9ull, 0xAF87023B9BF0EE6Bull,
+};
+
+static const int16_t format_cached_e[87] =
+{
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066,
+};
+
+static const uint32_t format_pow10[10] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+static unsigned Format$clz64(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+#ifdef _M_X64
+    _BitScanReverse64(&index, value);
+    return 63 - (unsigned)index;
+#else
+    if (value >> 32)
+    {
+        _BitScanReverse(&index, (unsigned long)(value >> 32));
+        return 31 - (unsigned)index;
+    }
+    _BitScanReverse(&index, (unsigned long)value);
+    return 63 - (unsigned)index;
+#endif
+#else
+    return (unsigned)__builtin_clzll(value);
+#endif
+}
+
+static DiyFp DiyFp$normalize(DiyFp value)
+{
+    unsigned shift = Format$clz64(value.f);
+    value.f <<= shift;
+    value.e -= (int)shift;
+    return value;
+}
+
+// Product rounded to the top 64 bits
+static DiyFp DiyFp$multiply(DiyFp x, DiyFp y)
+{
+    const uint64_t M32 = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & M32;
+    uint64_t c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+
+    uint64_t mid = (bd >> 32) + (ad & M32) + (bc & M32);
+    mid += (uint64_t)1 << 31;
+
+    DiyFp result = { ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64 };
+    return result;
+}
+
+// Cached power c such that the product with a value of binary exponent
+// e lands in a range DigitGen can handle. k receives c's decimal exponent.
+static DiyFp Format$cached_power(int e, int *k)
+{
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+    if (dk - ik > 0.0)
+    {
+        ++ik;
+    }
+
+    unsigned index = (unsigned)((ik >> 3) + 1);
+    *k = -(-348 + (int)(index << 3));
+
+    DiyFp power = { format_cached_f[index], format_cached_e[index] };
+    return power;
+}
+
+// Nudges the last digit towards the real value while it stays in range
+static void Format$grisu_round(char *buffer, size_t len, uint64_t delta, uint64_t rest,
+                               uint64_t ten_kappa, uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static size_t Format$digit_gen(DiyFp w, DiyFp mp, uint64_t delta, char *buffer, int *k)
+{
+    DiyFp one = { (uint64_t)1 << -mp.e, mp.e };
+    uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = (int)Format$digit_count(p1);
+    size_t len = 0;
+
+    // Integer part
+    while (kappa > 0)
+    {
+        uint32_t pow10 = format_pow10[kappa - 1];
+        uint32_t digit = p1 / pow10;
+        p1 %= pow10;
+        if (digit || len)
+        {
+            buffer[len++] = (char)('0' + digit);
+        }
+        --kappa;
+
+        uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta)
+        {
+            *k += kappa;
+            Format$grisu_round(buffer, len, delta, rest, (uint64_t)format_pow10[kappa] << -one.e, wp_w);
+            return len;
+        }
+    }
+
+    // Fractional part
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+        char digit = (char)(p2 >> -one.e);
+        if (digit || len)
+        {
+            buffer[len++] = (char)('0' + digit);
+        }
+        p2 &= one.f - 1;
+        --kappa;
+
+        if (p2 < delta)
+        {
+            *k += kappa;
+            int index = -kappa;
+            Format$grisu_round(buffer, len, delta, p2, one.f, wp_w * (index < 10 ? format_pow10[index] : 0));
+            return len;
+        }
+    }
+}
+
+// Shortest digits for f * 2^e, where lower_closer is set when the
+// gap to the next value down is half the gap to the next value up
+static size_t Format$grisu2(uint64_t f, int e, bool lower_closer, char *buffer, int *k)
+{
+    DiyFp v = { f, e };
+    DiyFp plus = { (f << 1) + 1, e - 1 };
+    DiyFp minus = { (f << 1) - 1, e - 1 };
+    if (lower_closer)
+    {
+        minus.f = (f << 2) - 1;
+        minus.e = e - 2;
+    }
+
+    plus = DiyFp$normalize(plus);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    DiyFp power = Format$cached_power(plus.e, k);
+    DiyFp w = DiyFp$multiply(DiyFp$normalize(v), power);
+    DiyFp wp = DiyFp$multiply(plus, power);
+    DiyFp wm = DiyFp$multiply(minus, power);
+
+    // Stay strictly inside the boundaries, which the rounding could have crossed
+    wm.f++;
+    wp.f--;
+    return Format$digit_gen(w, wp, wp.f - wm.f, buffer, k);
+}
+
+static size_t Format$exponent(char *buffer, int exponent)
+{
+    size_t len = 0;
+    if (exponent < 0)
+    {
+        buffer[len++] = '-';
+        exponent = -exponent;
+    }
+    return len + Format$uint(buffer + len, (uint64_t)exponent);
+}
+
+// Lays out digits * 10^k as either plain decimal or scientific notation
+static size_t Format$prettify(char *buffer, size_t len, int k)
+{
+    int kk = (int)len + k; // 10^(kk - 1) <= value < 10^kk
+    if (k >= 0 && kk <= 21)
+    {
+        // 1234e7 -> 12340000000.0
+        for (int i = (int)len; i < kk; ++i)
+        {
+            buffer[i] = '0';
+        }
+        buffer[kk] = '.';
+        buffer[kk + 1] = '0';
+        return (size_t)kk + 2;
+    }
+    if (kk > 0 && kk <= 21)
+    {
+        // 1234e-2 -> 12.34
+        memmove(buffer + kk + 1, buffer + kk, len - (size_t)kk);
+        buffer[kk] = '.';
+        return len + 1;
+    }
+    if (kk > -6 && kk <= 0)
+    {
+        // 1234e-6 -> 0.001234
+        size_t offset = (size_t)(2 - kk);
+        memmove(buffer + offset, buffer, len);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        for (size_t i = 2; i < offset; ++i)
+        {
+            buffer[i] = '0';
+        }
+        return len + offset;
+    }
+    if (len == 1)
+    {
+        // 1e30
+        buffer[1] = 'e';
+        return 2 + Format$exponent(buffer + 2, kk - 1);
+    }
+
+    // 1234e30 -> 1.234e33
+    memmove(buffer + 2, buffer + 1, len - 1);
+    buffer[1] = '.';
+    buffer[len + 1] = 'e';
+    return len + 2 + Format$exponent(buffer + len + 2, kk - 1);
+}
+
+// Zeroes, infinities and NaNs, or 0 if the value is finite and nonzero
+static size_t Format$special(char *buffer, bool negative, bool is_zero, bool is_inf, bool is_nan)
+{
+    const char *text = is_nan ? "nan" : is_inf ? (negative ? "-inf" : "inf") :
+                       is_zero ? (negative ? "-0.0" : "0.0") : NULL;
+    if (!text)
+    {
+        return 0;
+    }
+
+    size_t len = strlen(text);
+    memcpy(buffer, text, len);
+    return len;
+}
+
+size_t Format$double(char *buffer, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool negative = (bits >> 63) != 0;
+    unsigned biased = (unsigned)((bits >> 52) & 0x7FF);
+    uint64_t significand = bits & (((uint64_t)1 << 52) - 1);
+
+    size_t special = Format$special(buffer, negative, !biased && !significand,
+                                    biased == 0x7FF && !significand, biased == 0x7FF && significand);
+    if (special)
+    {
+        return special;
+    }
+
+    size_t sign = 0;
+    if (negative)
+    {
+        buffer[sign++] = '-';
+    }
+
+    // Subnormals have no hidden bit and share the smallest exponent
+    uint64_t f = biased ? significand | ((uint64_t)1 << 52) : significand;
+    int e = biased ? (int)biased - 1075 : -1074;
+    int k = 0;
+    size_t len = Format$grisu2(f, e, biased > 1 && !significand, buffer + sign, &k);
+    return sign + Format$prettify(buffer + sign, len, k);
+}
+
+size_t Format$float(char *buffer, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool negative = (bits >> 31) != 0;
+    unsigned biased = (bits >> 23) & 0xFF;
+    uint32_t significand = bits & ((1u << 23) - 1);
+
+    size_t special = Format$special(buffer, negative, !biased && !significand,
+                                    biased == 0xFF && !significand, biased == 0xFF && significand);
+    if (special)
+    {
+        return special;
+    }
+
+    size_t sign = 0;
+    if (negative)
+    {
+        buffer[sign++] = '-';
+    }
+
+    // Same as doubles, but with the float's own boundaries so
+    // the digits are the shortest that read back as this float
+    uint64_t f = biased ? significand | (1u << 23) : significand;
+    int e = biased ? (int)biased - 150 : -149;
+    int k = 0;
+    size_t len = Format$grisu2(f, e, biased > 1 && !significand, buffer + sign, &k);
+    return sign + Format$prettify(buffer + sign, len, k);
+}
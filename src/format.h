@@ -0,0 +1,30 @@
+////////////////////////////////////////////
+// File    : format.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Number formatting that doesn't go through printf. Each function writes
+// into buffer, which needs room for FORMAT_NUMBER_MAX characters, and
+// returns the number of characters written. Nothing is NUL terminated.
+
+#define FORMAT_NUMBER_MAX 32
+
+size_t Format$int(char *buffer, int64_t value);
+size_t Format$uint(char *buffer, uint64_t value);
+// Lowercase, no prefix or leading zeroes
+size_t Format$hex(char *buffer, uint64_t value);
+// The shortest digits that read back as the same value, laid out
+// like 1.0, 0.25, 1e30 or 1.5e-7. Also inf, -inf and nan.
+size_t Format$double(char *buffer, double value);
+size_t Format$float(char *buffer, float value);
+
+// Number of characters Format$uint and Format$hex write for value
+unsigned Format$digit_count(uint64_t value);
+unsigned Format$hex_digit_count(uint64_t value);
@@ -0,0 +1,52 @@
+////////////////////////////////////////////
+// File    : hash.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "hash.h"
+#include <string.h>
+
+#define HASH_K1 0x87C37B91114253D5ull
+#define HASH_K2 0x4CF5AD432745937Full
+
+static uint64_t Hash$rotl(uint64_t value, unsigned bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Hash$mix(uint64_t value)
+{
+    // Murmur3's finalizer
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t Hash$bytes(const void *data, size_t len)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    // Seeding with the length keeps trailing zeros from colliding
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ ((uint64_t)len * HASH_K2);
+    while (len >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        hash = Hash$rotl(hash ^ (word * HASH_K1), 29) * HASH_K2;
+        bytes += 8;
+        len -= 8;
+    }
+
+    if (len)
+    {
+        uint64_t word = 0;
+        memcpy(&word, bytes, len);
+        hash = Hash$rotl(hash ^ (word * HASH_K1), 29) * HASH_K2;
+    }
+
+    return Hash$mix(hash);
+}
@@ -0,0 +1,15 @@
+////////////////////////////////////////////
+// File    : hash.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Scramble a 64-bit value so every input bit affects every output bit
+uint64_t Hash$mix(uint64_t value);
+// General purpose hash for arbitrary memory, not cryptographically secure
+uint64_t Hash$bytes(const void *data, size_t len);
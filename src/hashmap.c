@@ -0,0 +1,600 @@
+////////////////////////////////////////////
+// File    : hashmap.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "hashmap.h"
+#include "rtti.h"
+#include "helpers.h"
+#include <string.h>
+#include <assert.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASHMAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Control bytes of full slots are never negative
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+#define HASHMAP_MISSING ((size_t)-1)
+
+/////////////////////////////////////
+// Control byte groups
+
+static unsigned HashMap$ctz(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// Bit i is set if group[i] == ctrl
+static uint32_t HashMap$match(const int8_t *group, int8_t ctrl)
+{
+#ifdef HASHMAP_SSE2
+    __m128i bytes = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(ctrl)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < HASHMAP_GROUP; ++i)
+    {
+        mask |= (uint32_t)(group[i] == ctrl) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i is set if group[i] is empty or deleted
+static uint32_t HashMap$match_free(const int8_t *group)
+{
+#ifdef HASHMAP_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < HASHMAP_GROUP; ++i)
+    {
+        mask |= (uint32_t)(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+/////////////////////////////////////
+// Storage
+
+static size_t HashMap$max_load(size_t cap)
+{
+    // Up to 7/8 full, which keeps the expected probe within a group or two
+    return cap - cap / 8;
+}
+
+static size_t HashMap$align(size_t offset, unsigned alignment)
+{
+    if (alignment < 2)
+    {
+        return offset;
+    }
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+static void HashMap$allocate(HashMap *this, size_t cap)
+{
+    // The control bytes, hashes, keys and values are separate arrays
+    // in one block, so probing only touches the control bytes and hashes
+    size_t hashes_at = cap;
+    size_t keys_at = HashMap$align(hashes_at + cap * sizeof(size_t), this->key_type->alignment);
+    size_t values_at = HashMap$align(keys_at + cap * this->key_type->size, this->value_type->alignment);
+    size_t bytes = values_at + cap * this->value_type->size;
+
+    char *block = malloc(bytes);
+    assert(block && "Uh oh, failed to allocate memory!");
+    memset(block, CTRL_EMPTY, cap);
+
+    this->ctrl = (int8_t *)block;
+    this->hashes = (size_t *)(block + hashes_at);
+    this->keys = block + keys_at;
+    this->values = block + values_at;
+    this->cap = cap;
+    this->growth_left = HashMap$max_load(cap) - this->len;
+}
+
+/////////////////////////////////////
+// Probing
+
+static size_t HashMap$find(const HashMap *this, const void *key, size_t hash)
+{
+    if (!this->cap)
+    {
+        return HASHMAP_MISSING;
+    }
+
+    // The low 7 bits go in the control byte, the rest pick the group
+    size_t group_mask = this->cap / HASHMAP_GROUP - 1;
+    size_t group = (hash >> 7) & group_mask;
+    int8_t h2 = (int8_t)(hash & 0x7F);
+
+    // Triangular steps visit every group of a power of two table
+    for (size_t step = 1;; ++step)
+    {
+        const int8_t *ctrl = this->ctrl + group * HASHMAP_GROUP;
+        uint32_t mask = HashMap$match(ctrl, h2);
+        while (mask)
+        {
+            size_t slot = group * HASHMAP_GROUP + HashMap$ctz(mask);
+            // Only keys with their own equality check the cached hash first,
+            // plain keys are cheaper to compare than another cache miss
+            if ((!this->key_type->equals || this->hashes[slot] == hash) &&
+                Type$equal_values(this->key_type, this->keys + slot * this->key_type->size, key))
+            {
+                return slot;
+            }
+            mask &= mask - 1;
+        }
+
+        // Inserts fill the first free slot along the probe,
+        // so an empty slot means the key isn't any further on
+        if (HashMap$match(ctrl, CTRL_EMPTY))
+        {
+            return HASHMAP_MISSING;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+static size_t HashMap$find_free(const HashMap *this, size_t hash)
+{
+    size_t group_mask = this->cap / HASHMAP_GROUP - 1;
+    size_t group = (hash >> 7) & group_mask;
+    for (size_t step = 1;; ++step)
+    {
+        uint32_t mask = HashMap$match_free(this->ctrl + group * HASHMAP_GROUP);
+        if (mask)
+        {
+            return group * HASHMAP_GROUP + HashMap$ctz(mask);
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+static void HashMap$rehash(HashMap *this, size_t cap)
+{
+    HashMap old = *this;
+    HashMap$allocate(this, cap);
+
+    // Entries are moved with their cached hash, no key is hashed again
+    for (size_t i = 0; i < old.cap; ++i)
+    {
+        if (old.ctrl[i] < 0)
+        {
+            continue;
+        }
+
+        size_t hash = old.hashes[i];
+        size_t slot = HashMap$find_free(this, hash);
+        this->ctrl[slot] = (int8_t)(hash & 0x7F);
+        this->hashes[slot] = hash;
+        memcpy(this->keys + slot * this->key_type->size,
+               old.keys + i * this->key_type->size, this->key_type->size);
+        memcpy(this->values + slot * this->value_type->size,
+               old.values + i * this->value_type->size, this->value_type->size);
+    }
+
+    free(old.ctrl);
+}
+
+static void HashMap$grow(HashMap *this)
+{
+    // If deleted slots are what's filling the table, clean them
+    // out at the same size instead of doubling
+    if (this->cap && this->len + 1 <= HashMap$max_load(this->cap) / 2)
+    {
+        HashMap$rehash(this, this->cap);
+    }
+    else
+    {
+        HashMap$rehash(this, this->cap ? this->cap * 2 : HASHMAP_GROUP);
+    }
+}
+
+/////////////////////////////////////
+// Public interface
+
+HashMap HashMap$new(const Type *key_type, const Type *value_type)
+{
+    HashMap map = { NULL };
+    map.key_type = key_type;
+    map.value_type = value_type;
+    return map;
+}
+
+HashMap HashMap$copy(const HashMap *map)
+{
+    HashMap copy = HashMap$new(map->key_type, map->value_type);
+    if (!map->cap)
+    {
+        return copy;
+    }
+
+    // Same size and same hashes means every entry lands in the same slot,
+    // and plain data can be copied with the rest of the block
+    copy.len = map->len;
+    HashMap$allocate(&copy, map->cap);
+    copy.growth_left = map->growth_left;
+    memcpy(copy.ctrl, map->ctrl, map->cap);
+    memcpy(copy.hashes, map->hashes, map->cap * sizeof(size_t));
+
+    if (Type$has_traits(map->key_type, TT_TRIVIAL_COPY) &&
+        Type$has_traits(map->value_type, TT_TRIVIAL_COPY))
+    {
+        memcpy(copy.keys, map->keys, map->cap * map->key_type->size);
+        memcpy(copy.values, map->values, map->cap * map->value_type->size);
+        return copy;
+    }
+
+    for (size_t i = HashMap$next(map, 0); i < map->cap; i = HashMap$next(map, i + 1))
+    {
+        Type$copy_value(map->key_type, HashMap$key_at(&copy, i), HashMap$key_at(map, i));
+        Type$copy_value(map->value_type, HashMap$value_at(&copy, i), HashMap$value_at(map, i));
+    }
+    return copy;
+}
+
+void HashMap$free(HashMap *this)
+{
+    HashMap$clear(this);
+    free(this->ctrl);
+    *this = HashMap$new(this->key_type, this->value_type);
+}
+
+size_t HashMap$len(const HashMap *this)
+{
+    return this->len;
+}
+
+void HashMap$reserve(HashMap *this, size_t count)
+{
+    if (count <= HashMap$max_load(this->cap))
+    {
+        return;
+    }
+
+    size_t cap = this->cap ? this->cap : HASHMAP_GROUP;
+    while (HashMap$max_load(cap) < count)
+    {
+        cap *= 2;
+    }
+    HashMap$rehash(this, cap);
+}
+
+void HashMap$clear(HashMap *this)
+{
+    if (!Type$has_traits(this->key_type, TT_TRIVIAL_DESTROY) ||
+        !Type$has_traits(this->value_type, TT_TRIVIAL_DESTROY))
+    {
+        for (size_t i = HashMap$next(this, 0); i < this->cap; i = HashMap$next(this, i + 1))
+        {
+            Type$destroy_value(this->key_type, HashMap$key_at(this, i));
+            Type$destroy_value(this->value_type, HashMap$value_at(this, i));
+        }
+    }
+
+    if (this->cap)
+    {
+        memset(this->ctrl, CTRL_EMPTY, this->cap);
+    }
+    this->len = 0;
+    this->growth_left = HashMap$max_load(this->cap);
+}
+
+bool HashMap$insert(HashMap *this, void *key, void *value)
+{
+    size_t hash = Type$hash_value(this->key_type, key);
+    size_t slot = HashMap$find(this, key, hash);
+    if (slot != HASHMAP_MISSING)
+    {
+        void *old = HashMap$value_at(this, slot);
+        Type$destroy_value(this->value_type, old);
+        memcpy(old, value, this->value_type->size);
+        Type$destroy_value(this->key_type, key);
+        return false;
+    }
+
+    if (!this->cap)
+    {
+        HashMap$grow(this);
+    }
+
+    // Reusing a deleted slot doesn't bring the table any closer to full
+    slot = HashMap$find_free(this, hash);
+    if (!this->growth_left && this->ctrl[slot] == CTRL_EMPTY)
+    {
+        HashMap$grow(this);
+        slot = HashMap$find_free(this, hash);
+    }
+    if (this->ctrl[slot] == CTRL_EMPTY)
+    {
+        this->growth_left--;
+    }
+
+    this->ctrl[slot] = (int8_t)(hash & 0x7F);
+    this->hashes[slot] = hash;
+    memcpy(HashMap$key_at(this, slot), key, this->key_type->size);
+    memcpy(HashMap$value_at(this, slot), value, this->value_type->size);
+    this->len++;
+    return true;
+}
+
+void *HashMap$get(const HashMap *this, const void *key)
+{
+    size_t slot = HashMap$find(this, key, Type$hash_value(this->key_type, key));
+    return slot == HASHMAP_MISSING ? NULL : HashMap$value_at(this, slot);
+}
+
+bool HashMap$contains(const HashMap *this, const void *key)
+{
+    return HashMap$find(this, key, Type$hash_value(this->key_type, key)) != HASHMAP_MISSING;
+}
+
+bool HashMap$remove(HashMap *this, const void *key)
+{
+    size_t slot = HashMap$find(this, key, Type$hash_value(this->key_type, key));
+    if (slot == HASHMAP_MISSING)
+    {
+        return false;
+    }
+
+    Type$destroy_value(this->key_type, HashMap$key_at(this, slot));
+    Type$destroy_value(this->value_type, HashMap$value_at(this, slot));
+
+    // Probes stop at a group with an empty slot, so if this group has
+    // one nobody probes past it and the slot can be emptied outright
+    const int8_t *group = this->ctrl + slot / HASHMAP_GROUP * HASHMAP_GROUP;
+    if (HashMap$match(group, CTRL_EMPTY))
+    {
+        this->ctrl[slot] = CTRL_EMPTY;
+        this->growth_left++;
+    }
+    else
+    {
+        this->ctrl[slot] = CTRL_DELETED;
+    }
+
+    this->len--;
+    return true;
+}
+
+size_t HashMap$next(const HashMap *this, size_t slot)
+{
+    while (slot < this->cap && this->ctrl[slot] < 0)
+    {
+        ++slot;
+    }
+    return slot;
+}
+
+void *HashMap$key_at(const HashMap *this, size_t slot)
+{
+    return this->keys + slot * this->key_type->size;
+}
+
+void *HashMap$value_at(const HashMap *this, size_t slot)
+{
+    return this->values + slot * this->value_type->size;
+}
+
+///////////////////////////////////////////////
+// HashMap RTTI
+
+// Pointer to the value held by an argument, in the layout the map stores it
+static void *HashMap$arg_data(Any *arg)
+{
+    return arg->type->kind == TK_COMPLEX ? Any$data(arg) : (void *)&arg->value;
+}
+
+// Make sure we own an argument, so its value can be moved into the map
+static void *HashMap$own_arg(Any *arg)
+{
+    if (arg->type->kind == TK_COMPLEX && arg->storage == AS_REF)
+    {
+        *arg = Any$copy(*arg);
+    }
+    return HashMap$arg_data(arg);
+}
+
+static Any rtti_constructor(void *obj, unsigned arg_count, Any *arguments)
+{
+    (obj); // unreferenced parameter
+
+    switch (arg_count)
+    {
+        case 1: // Copy constructor
+        {
+            assert(arguments[0].type == &type_hashmap);
+
+            HashMap temp;
+            if (arguments[0].storage == AS_REF)
+            {
+                temp = HashMap$copy((const HashMap *)Any$data(&arguments[0]));
+            }
+            else
+            {
+                Any$unpack(arguments[0], &temp);
+                Any$soft_release(&arguments[0]);
+            }
+            return Any$from_complex(&type_hashmap, &temp);
+        }
+        case 2: // Key and value types
+        {
+            assert(arguments[0].type == &type_type_ptr && arguments[1].type == &type_type_ptr);
+
+            HashMap temp = HashMap$new((const Type *)arguments[0].value.ptr,
+                                       (const Type *)arguments[1].value.ptr);
+            return Any$from_complex(&type_hashmap, &temp);
+        }
+        default: // Invalid
+        {
+            return Any$EMPTY;
+        }
+    }
+}
+
+static Member constructor_member =
+{
+    ".ctor",
+    rtti_constructor,
+    2, // Maximum number of args
+    NULL, // Argument types; function is overloaded
+    &type_hashmap, // Return type
+    true, // static
+    true, // overloaded
+};
+
+static Any rtti_destructor(void *obj, unsigned arg_count, Any *arguments)
+{
+    (arguments); // unreferenced parameter
+    assert(arg_count == 0);
+    HashMap$free((HashMap *)obj);
+    return Any$VOID;
+}
+
+static Member destructor_member =
+{
+    ".dtor",
+    rtti_destructor,
+    0, // Number of args
+    NULL, // No arguments
+    &type_void, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static Any rtti_len(void *obj, unsigned arg_count, Any *arguments)
+{
+    (arg_count, arguments); // unreferenced parameters
+    return Any$from_size_t(HashMap$len((const HashMap *)obj));
+}
+
+static Member len_member =
+{
+    "len",
+    rtti_len,
+    0, NULL, // Args
+    &type_size_t, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static Any rtti_get(void *obj, unsigned arg_count, Any *arguments)
+{
+    assert(arg_count == 1);
+
+    HashMap *this = (HashMap *)obj;
+    assert(arguments[0].type == this->key_type && "Invalid key type passed to HashMap$get");
+
+    // Complex values are returned by reference, the map still owns them
+    void *value = HashMap$get(this, HashMap$arg_data(&arguments[0]));
+    if (!value)
+    {
+        return Any$EMPTY;
+    }
+    if (this->value_type->kind == TK_COMPLEX)
+    {
+        return Any$ref_complex(this->value_type, value);
+    }
+    return Any$from_complex(this->value_type, this->value_type->kind == TK_POINTER
+        ? *(void **)value
+        : value);
+}
+
+static Member get_member =
+{
+    "get",
+    rtti_get,
+    1, NULL, // Args, the key type depends on the map
+    &type_any, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static Any rtti_insert(void *obj, unsigned arg_count, Any *arguments)
+{
+    assert(arg_count == 2);
+
+    HashMap *this = (HashMap *)obj;
+    assert(arguments[0].type == this->key_type && "Invalid key type passed to HashMap$insert");
+    assert(arguments[1].type == this->value_type && "Invalid value type passed to HashMap$insert");
+
+    HashMap$insert(this, HashMap$own_arg(&arguments[0]), HashMap$own_arg(&arguments[1]));
+
+    // The map owns the values now
+    Any$soft_release(&arguments[0]);
+    Any$soft_release(&arguments[1]);
+    return Any$VOID;
+}
+
+static Member insert_member =
+{
+    "insert",
+    rtti_insert,
+    2, NULL, // Args, the types depend on the map
+    &type_void, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static Any rtti_remove(void *obj, unsigned arg_count, Any *arguments)
+{
+    assert(arg_count == 1);
+
+    HashMap *this = (HashMap *)obj;
+    assert(arguments[0].type == this->key_type && "Invalid key type passed to HashMap$remove");
+
+    HashMap$remove(this, HashMap$arg_data(&arguments[0]));
+    return Any$VOID;
+}
+
+static Member remove_member =
+{
+    "remove",
+    rtti_remove,
+    1, NULL, // Args, the key type depends on the map
+    &type_void, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static const Member *member_list[] =
+{
+    &constructor_member,
+    &destructor_member,
+    &len_member,
+    &get_member,
+    &insert_member,
+    &remove_member,
+};
+
+struct Type type_hashmap =
+{
+    TK_COMPLEX,
+    sizeof(HashMap), // Size
+    sizeof(void *), // Alignment
+    "HashMap", // Name
+    NULL, // Subtype
+    &constructor_member,
+    &destructor_member,
+
+    0, NULL, // No accessible fields
+    ARRAY_SIZE(member_list), member_list,
+    0, NULL, // HashMap does not implement any interfaces
+};
@@ -0,0 +1,57 @@
+////////////////////////////////////////////
+// File    : hashmap.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct HashMap HashMap;
+struct Type;
+
+// Keys are hashed and compared with Type$hash_value and Type$equal_values
+HashMap HashMap$new(const struct Type *key_type, const struct Type *value_type);
+HashMap HashMap$copy(const HashMap *map);
+void    HashMap$free(HashMap *this);
+
+size_t HashMap$len(const HashMap *this);
+void   HashMap$reserve(HashMap *this, size_t count);
+void   HashMap$clear(HashMap *this);
+
+// Takes ownership of both the key and the value. If the key is already
+// present its old value and the new key are destroyed, and false is returned.
+bool  HashMap$insert(HashMap *this, void *key, void *value);
+// Pointer to the value stored for key, or NULL if there isn't one.
+// Inserting may move every value, so don't hold on to it.
+void *HashMap$get(const HashMap *this, const void *key);
+bool  HashMap$contains(const HashMap *this, const void *key);
+// Destroys the key and value, returns false if the key wasn't present
+bool  HashMap$remove(HashMap *this, const void *key);
+
+// Iterate over the entries with
+//   for (size_t i = HashMap$next(&map, 0); i < map.cap; i = HashMap$next(&map, i + 1))
+size_t HashMap$next(const HashMap *this, size_t slot);
+void  *HashMap$key_at(const HashMap *this, size_t slot);
+void  *HashMap$value_at(const HashMap *this, size_t slot);
+
+extern struct Type type_hashmap;
+
+// Slots are probed a group at a time, matching all of a group's
+// control bytes at once
+#define HASHMAP_GROUP 16
+struct HashMap
+{
+    const struct Type *key_type;
+    const struct Type *value_type;
+    int8_t *ctrl; // Per slot: empty, deleted, or the low 7 bits of the key's hash
+    size_t *hashes; // Full hash of each key, so growing never rehashes a key
+    char *keys;
+    char *values;
+    size_t len;
+    size_t cap; // 0, or a power of two that's at least HASHMAP_GROUP
+    size_t growth_left; // Empty slots we may still fill before growing
+};
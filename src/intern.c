@@ -0,0 +1,201 @@
+////////////////////////////////////////////
+// File    : intern.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "intern.h"
+#include "hash.h"
+#include "sync.h"
+#include <string.h>
+#include <assert.h>
+
+// Atoms are carved out of chunks of this size, longer
+// strings get an allocation of their own
+#define INTERN_CHUNK_SIZE (16 * 1024)
+#define INTERN_MIN_SLOTS 1024
+
+typedef struct InternEntry InternEntry;
+typedef struct InternTable InternTable;
+
+// The characters follow the entry, and the atom points at them
+struct InternEntry
+{
+    size_t hash;
+    size_t len;
+};
+
+struct InternTable
+{
+    size_t mask;
+    size_t count;
+    InternEntry *volatile *slots; // Filled slots are never changed
+    InternTable *previous; // Kept alive for readers that are still probing it
+};
+
+static InternTable *volatile intern_table;
+static SpinLock intern_lock = SPINLOCK_INIT;
+static char *intern_chunk;
+static size_t intern_chunk_left;
+
+static const char *Intern$chars(const InternEntry *entry)
+{
+    return (const char *)(entry + 1);
+}
+
+static const InternEntry *Intern$entry(Atom atom)
+{
+    return (const InternEntry *)atom - 1;
+}
+
+// Only ever called from readers, slots are loaded with acquire
+// so the entry is fully written by the time we see it
+static Atom Intern$lookup(const InternTable *table, const char *chars, size_t len, size_t hash)
+{
+    for (size_t i = hash & table->mask;; i = (i + 1) & table->mask)
+    {
+        const InternEntry *entry = Atomic$load_ptr((void *volatile *)&table->slots[i]);
+        if (!entry)
+        {
+            return NULL;
+        }
+
+        if (entry->hash == hash && entry->len == len &&
+            memcmp(Intern$chars(entry), chars, len) == 0)
+        {
+            return Intern$chars(entry);
+        }
+    }
+}
+
+static InternTable *Intern$new_table(size_t slot_count)
+{
+    InternTable *table = calloc(1, sizeof(InternTable) + slot_count * sizeof(InternEntry *));
+    assert(table && "Uh oh, failed to allocate memory!");
+    table->mask = slot_count - 1;
+    table->slots = (InternEntry *volatile *)(table + 1);
+    return table;
+}
+
+static void Intern$place(InternTable *table, InternEntry *entry)
+{
+    size_t i = entry->hash & table->mask;
+    while (table->slots[i])
+    {
+        i = (i + 1) & table->mask;
+    }
+
+    // Publish the entry only once it's complete
+    Atomic$store_ptr((void *volatile *)&table->slots[i], entry);
+    table->count++;
+}
+
+static InternEntry *Intern$new_entry(const char *chars, size_t len, size_t hash)
+{
+    size_t align = sizeof(InternEntry);
+    size_t bytes = (sizeof(InternEntry) + len + 1 + align - 1) / align * align;
+
+    char *block;
+    if (bytes > INTERN_CHUNK_SIZE / 4)
+    {
+        block = malloc(bytes);
+        assert(block && "Uh oh, failed to allocate memory!");
+    }
+    else
+    {
+        if (intern_chunk_left < bytes)
+        {
+            // The rest of the old chunk is wasted, atoms live forever anyway
+            intern_chunk = malloc(INTERN_CHUNK_SIZE);
+            assert(intern_chunk && "Uh oh, failed to allocate memory!");
+            intern_chunk_left = INTERN_CHUNK_SIZE;
+        }
+        block = intern_chunk;
+        intern_chunk += bytes;
+        intern_chunk_left -= bytes;
+    }
+
+    InternEntry *entry = (InternEntry *)block;
+    entry->hash = hash;
+    entry->len = len;
+    memcpy(block + sizeof(InternEntry), chars, len);
+    block[sizeof(InternEntry) + len] = 0;
+    return entry;
+}
+
+static Atom Intern$insert(const char *chars, size_t len, size_t hash)
+{
+    SpinLock$lock(&intern_lock);
+
+    // Someone may have interned it since we looked
+    InternTable *table = intern_table;
+    Atom atom = table ? Intern$lookup(table, chars, len, hash) : NULL;
+    if (atom)
+    {
+        SpinLock$unlock(&intern_lock);
+        return atom;
+    }
+
+    // Keep the table at most half full. Readers may still be probing
+    // the old table, so it's copied rather than rehashed in place.
+    if (!table || (table->count + 1) * 2 > table->mask + 1)
+    {
+        InternTable *grown = Intern$new_table(table ? (table->mask + 1) * 2 : INTERN_MIN_SLOTS);
+        if (table)
+        {
+            for (size_t i = 0; i <= table->mask; ++i)
+            {
+                if (table->slots[i])
+                {
+                    Intern$place(grown, table->slots[i]);
+                }
+            }
+        }
+
+        grown->previous = table;
+        Atomic$store_ptr((void *volatile *)&intern_table, grown);
+        table = grown;
+    }
+
+    InternEntry *entry = Intern$new_entry(chars, len, hash);
+    Intern$place(table, entry);
+
+    SpinLock$unlock(&intern_lock);
+    return Intern$chars(entry);
+}
+
+Atom Intern$bytes(const char *chars, size_t len)
+{
+    size_t hash = (size_t)Hash$bytes(chars, len);
+
+    const InternTable *table = Atomic$load_ptr((void *volatile *)&intern_table);
+    Atom atom = table ? Intern$lookup(table, chars, len, hash) : NULL;
+    return atom ? atom : Intern$insert(chars, len, hash);
+}
+
+Atom Intern$cstr(const char *cstr)
+{
+    return Intern$bytes(cstr, strlen(cstr));
+}
+
+Atom Intern$string(String str)
+{
+    return Intern$bytes(String$cstr(&str), String$len(&str));
+}
+
+Atom Intern$find(const char *cstr)
+{
+    size_t len = strlen(cstr);
+    const InternTable *table = Atomic$load_ptr((void *volatile *)&intern_table);
+    return table ? Intern$lookup(table, cstr, len, (size_t)Hash$bytes(cstr, len)) : NULL;
+}
+
+size_t Intern$len(Atom atom)
+{
+    return Intern$entry(atom)->len;
+}
+
+size_t Intern$hash(Atom atom)
+{
+    return Intern$entry(atom)->hash;
+}
@@ -0,0 +1,25 @@
+////////////////////////////////////////////
+// File    : intern.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "string.h"
+
+// An interned, nul-terminated string. Equal strings always intern to the
+// same pointer, so atoms can be compared with ==. Atoms are never freed.
+typedef const char *Atom;
+
+// Safe to call from any thread. Lookups of strings that are already
+// interned never take a lock.
+Atom Intern$cstr(const char *cstr);
+Atom Intern$bytes(const char *chars, size_t len);
+Atom Intern$string(String str);
+// Returns NULL if the string hasn't been interned, and never inserts it
+Atom Intern$find(const char *cstr);
+
+size_t Intern$len(Atom atom);
+// Same as (size_t)Hash$bytes over the atom's characters, without rehashing
+size_t Intern$hash(Atom atom);
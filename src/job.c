@@ -0,0 +1,501 @@
+////////////////////////////////////////////
+// File    : job.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "job.h"
+#include "thread.h"
+#include "pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+// Times an idle thread looks for work before it backs off
+#define JOB_SPIN_COUNT 256
+#define JOB_DEQUE_MIN_SIZE 256
+#define JOB_CACHE_LINE 64
+
+typedef struct JobBuffer JobBuffer;
+typedef struct JobDeque JobDeque;
+
+struct Job
+{
+    JobFunc func;
+    void *data;
+
+    const Member *member; // Set for Member jobs instead of func
+    Any *self;
+    unsigned arg_count;
+    Any args[JOB_MAX_ARGS];
+
+    JobCounter *counter;
+    Job *next; // Link in the shared queue or a counter's waiting list
+};
+
+struct JobBuffer
+{
+    intptr_t mask;
+    Job *volatile *slots;
+    JobBuffer *retired; // Smaller buffer this one replaced
+};
+
+// Chase-Lev deque. The owning worker pushes and pops at the bottom,
+// everyone else steals from the top.
+struct JobDeque
+{
+    volatile intptr_t top;
+    char top_pad[JOB_CACHE_LINE - sizeof(intptr_t)];
+    volatile intptr_t bottom;
+    JobBuffer *volatile buffer;
+    char bottom_pad[JOB_CACHE_LINE - sizeof(intptr_t) - sizeof(void *)];
+};
+
+// Jobs come from the pool, so they're cheap and freed on any thread
+static Type type_job = { TK_COMPLEX, sizeof(Job), sizeof(void *), "Job" };
+
+static unsigned job_worker_count;
+static Thread **job_threads;
+static JobDeque *job_deques;
+static volatile intptr_t job_stopping;
+static volatile intptr_t job_sleeping;
+static Semaphore *job_wake;
+
+// Jobs queued from threads that aren't workers
+static SpinLock job_shared_lock = SPINLOCK_INIT;
+static Job *volatile job_shared_head;
+static Job *job_shared_tail;
+
+static THREAD_LOCAL int job_worker = -1;
+static THREAD_LOCAL uint32_t job_random_state;
+
+/////////////////////////////////////
+// Deques
+
+static JobBuffer *JobDeque$new_buffer(intptr_t size)
+{
+    JobBuffer *buffer = malloc(sizeof(JobBuffer) + size * sizeof(Job *));
+    assert(buffer && "Uh oh, failed to allocate memory!");
+    buffer->mask = size - 1;
+    buffer->slots = (Job *volatile *)(buffer + 1);
+    buffer->retired = NULL;
+    return buffer;
+}
+
+static void JobDeque$push(JobDeque *this, Job *job)
+{
+    intptr_t bottom = this->bottom;
+    intptr_t top = Atomic$load(&this->top);
+    JobBuffer *buffer = this->buffer;
+
+    if (bottom - top > buffer->mask)
+    {
+        // Thieves may still be reading the old buffer, so it's
+        // kept around until the job system stops
+        JobBuffer *grown = JobDeque$new_buffer((buffer->mask + 1) * 2);
+        for (intptr_t i = top; i < bottom; ++i)
+        {
+            grown->slots[i & grown->mask] = buffer->slots[i & buffer->mask];
+        }
+        grown->retired = buffer;
+        Atomic$store_ptr((void *volatile *)&this->buffer, grown);
+        buffer = grown;
+    }
+
+    Atomic$store_ptr((void *volatile *)&buffer->slots[bottom & buffer->mask], job);
+    Atomic$store(&this->bottom, bottom + 1);
+}
+
+static Job *JobDeque$pop(JobDeque *this)
+{
+    // The full barrier makes the claim visible to thieves before we read top
+    intptr_t bottom = Atomic$add(&this->bottom, -1);
+    intptr_t top = Atomic$load(&this->top);
+    if (top > bottom)
+    {
+        Atomic$store(&this->bottom, bottom + 1);
+        return NULL;
+    }
+
+    JobBuffer *buffer = this->buffer;
+    Job *job = Atomic$load_ptr((void *volatile *)&buffer->slots[bottom & buffer->mask]);
+    if (top == bottom)
+    {
+        // Last job, so race the thieves for it
+        if (!Atomic$cas(&this->top, top, top + 1))
+        {
+            job = NULL;
+        }
+        Atomic$store(&this->bottom, bottom + 1);
+    }
+    return job;
+}
+
+static Job *JobDeque$steal(JobDeque *this)
+{
+    intptr_t top = Atomic$load(&this->top);
+    Atomic$fence();
+    intptr_t bottom = Atomic$load(&this->bottom);
+    if (top >= bottom)
+    {
+        return NULL;
+    }
+
+    JobBuffer *buffer = Atomic$load_ptr((void *volatile *)&this->buffer);
+    Job *job = Atomic$load_ptr((void *volatile *)&buffer->slots[top & buffer->mask]);
+    return Atomic$cas(&this->top, top, top + 1) ? job : NULL;
+}
+
+/////////////////////////////////////
+// Scheduling
+
+static uint32_t JobSystem$random(void)
+{
+    // xorshift32, only used to spread thieves over the victims
+    uint32_t x = job_random_state;
+    if (!x)
+    {
+        x = (uint32_t)(uintptr_t)&x | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    job_random_state = x;
+    return x;
+}
+
+static void JobSystem$push_shared(Job *job)
+{
+    job->next = NULL;
+    SpinLock$lock(&job_shared_lock);
+    if (job_shared_head)
+    {
+        job_shared_tail->next = job;
+    }
+    else
+    {
+        Atomic$store_ptr((void *volatile *)&job_shared_head, job);
+    }
+    job_shared_tail = job;
+    SpinLock$unlock(&job_shared_lock);
+}
+
+static Job *JobSystem$pop_shared(void)
+{
+    // Skip the lock in the usual case of nothing being there
+    if (!Atomic$load_ptr((void *volatile *)&job_shared_head))
+    {
+        return NULL;
+    }
+
+    SpinLock$lock(&job_shared_lock);
+    Job *job = job_shared_head;
+    if (job)
+    {
+        Atomic$store_ptr((void *volatile *)&job_shared_head, job->next);
+    }
+    SpinLock$unlock(&job_shared_lock);
+    return job;
+}
+
+static void JobSystem$schedule(Job *job)
+{
+    if (job_worker >= 0)
+    {
+        JobDeque$push(&job_deques[job_worker], job);
+    }
+    else
+    {
+        JobSystem$push_shared(job);
+    }
+
+    // Pairs with the barrier in JobSystem$sleep, so a worker on its way
+    // to sleep either finds this job or sees the wake up
+    Atomic$fence();
+    if (Atomic$load(&job_sleeping))
+    {
+        Semaphore$post(job_wake, 1);
+    }
+}
+
+static Job *JobSystem$find(void)
+{
+    Job *job = NULL;
+    if (job_worker >= 0)
+    {
+        job = JobDeque$pop(&job_deques[job_worker]);
+    }
+    if (!job)
+    {
+        job = JobSystem$pop_shared();
+    }
+
+    if (!job && job_worker_count)
+    {
+        unsigned start = JobSystem$random() % job_worker_count;
+        for (unsigned i = 0; i < job_worker_count && !job; ++i)
+        {
+            unsigned victim = (start + i) % job_worker_count;
+            if ((int)victim != job_worker)
+            {
+                job = JobDeque$steal(&job_deques[victim]);
+            }
+        }
+    }
+    return job;
+}
+
+static void JobCounter$finish(JobCounter *this)
+{
+    // Hold the lock while dropping the count, so JobCounter$wait can't
+    // return and let the counter go out of scope while we still use it
+    SpinLock$lock(&this->lock);
+    Job *waiting = NULL;
+    if (Atomic$add(&this->pending, -1) == 0)
+    {
+        waiting = this->waiting;
+        this->waiting = NULL;
+    }
+    SpinLock$unlock(&this->lock);
+
+    while (waiting)
+    {
+        Job *next = waiting->next;
+        JobSystem$schedule(waiting);
+        waiting = next;
+    }
+}
+
+static void Job$execute(Job *job)
+{
+    if (job->member)
+    {
+        void *obj = job->self ? Any$data(job->self) : NULL;
+        Any result = Member$invoke(job->member, obj, job->arg_count, job->args);
+        Any$free(&result);
+    }
+    else
+    {
+        job->func(job->data);
+    }
+
+    JobCounter *counter = job->counter;
+    Pool$free(&type_job, job);
+    if (counter)
+    {
+        JobCounter$finish(counter);
+    }
+}
+
+static Job *Job$new(JobCounter *counter)
+{
+    Job *job = Pool$alloc(&type_job);
+    memset(job, 0, sizeof(Job));
+    job->counter = counter;
+    if (counter)
+    {
+        Atomic$add(&counter->pending, 1);
+    }
+    return job;
+}
+
+/////////////////////////////////////
+// Workers
+
+static void JobSystem$sleep(void)
+{
+    Atomic$add(&job_sleeping, 1);
+
+    // Look once more now that anyone scheduling can see we're asleep
+    Job *job = JobSystem$find();
+    if (!job && !Atomic$load(&job_stopping))
+    {
+        Semaphore$wait(job_wake);
+    }
+
+    Atomic$add(&job_sleeping, -1);
+    if (job)
+    {
+        Job$execute(job);
+    }
+}
+
+static void JobSystem$worker(void *arg)
+{
+    job_worker = (int)(intptr_t)arg;
+    job_random_state = (uint32_t)(job_worker + 1) * 2654435761u;
+
+    unsigned spins = 0;
+    while (!Atomic$load(&job_stopping))
+    {
+        Job *job = JobSystem$find();
+        if (job)
+        {
+            Job$execute(job);
+            spins = 0;
+        }
+        else if (++spins < JOB_SPIN_COUNT)
+        {
+            Atomic$pause();
+        }
+        else
+        {
+            spins = 0;
+            JobSystem$sleep();
+        }
+    }
+
+    job_worker = -1;
+    Pool$flush_thread();
+}
+
+/////////////////////////////////////
+// Public interface
+
+void JobSystem$start(unsigned worker_count)
+{
+    assert(!job_threads && "The job system is already running");
+
+    if (!worker_count)
+    {
+        unsigned cores = Thread$cpu_count();
+        worker_count = cores > 1 ? cores - 1 : 1;
+    }
+
+    job_deques = calloc(worker_count, sizeof(JobDeque));
+    job_threads = malloc(worker_count * sizeof(Thread *));
+    assert(job_deques && job_threads && "Uh oh, failed to allocate memory!");
+    for (unsigned i = 0; i < worker_count; ++i)
+    {
+        job_deques[i].buffer = JobDeque$new_buffer(JOB_DEQUE_MIN_SIZE);
+    }
+
+    job_wake = Semaphore$new(0);
+    job_stopping = 0;
+    job_worker_count = worker_count;
+    for (unsigned i = 0; i < worker_count; ++i)
+    {
+        job_threads[i] = Thread$spawn(JobSystem$worker, (void *)(intptr_t)i);
+    }
+}
+
+void JobSystem$stop(void)
+{
+    if (!job_threads)
+    {
+        return;
+    }
+
+    Atomic$store(&job_stopping, 1);
+    Semaphore$post(job_wake, job_worker_count);
+    for (unsigned i = 0; i < job_worker_count; ++i)
+    {
+        Thread$join(job_threads[i]);
+    }
+
+    // Run whatever is still queued, in the deques or the shared list, so
+    // every counter reaches zero and Member jobs consume their args. Jobs
+    // they queue in turn go to the shared list and are picked up here too.
+    Job *job;
+    while ((job = JobSystem$find()) != NULL)
+    {
+        Job$execute(job);
+    }
+
+    for (unsigned i = 0; i < job_worker_count; ++i)
+    {
+
+        JobBuffer *buffer = job_deques[i].buffer;
+        while (buffer)
+        {
+            JobBuffer *retired = buffer->retired;
+            free(buffer);
+            buffer = retired;
+        }
+    }
+
+    free(job_threads);
+    free(job_deques);
+    Semaphore$free(job_wake);
+    job_threads = NULL;
+    job_deques = NULL;
+    job_worker_count = 0;
+}
+
+unsigned JobSystem$worker_count(void)
+{
+    return job_worker_count;
+}
+
+void Job$run(JobFunc func, void *data, JobCounter *counter)
+{
+    Job *job = Job$new(counter);
+    job->func = func;
+    job->data = data;
+    JobSystem$schedule(job);
+}
+
+void Job$run_after(JobCounter *after, JobFunc func, void *data, JobCounter *counter)
+{
+    Job *job = Job$new(counter);
+    job->func = func;
+    job->data = data;
+
+    // JobCounter$finish takes the same lock, so either it
+    // sees our job or we see the count already at zero
+    SpinLock$lock(&after->lock);
+    if (Atomic$load(&after->pending))
+    {
+        job->next = after->waiting;
+        after->waiting = job;
+        job = NULL;
+    }
+    SpinLock$unlock(&after->lock);
+
+    if (job)
+    {
+        JobSystem$schedule(job);
+    }
+}
+
+void Job$run_member(Any *self, const Member *member, unsigned arg_count,
+                    Any *args, JobCounter *counter)
+{
+    assert(arg_count <= JOB_MAX_ARGS && "Too many arguments for a Member job");
+
+    Job *job = Job$new(counter);
+    job->member = member;
+    job->self = self;
+    job->arg_count = arg_count;
+    if (arg_count)
+    {
+        memcpy(job->args, args, arg_count * sizeof(Any));
+    }
+    JobSystem$schedule(job);
+}
+
+void JobCounter$wait(JobCounter *counter)
+{
+    unsigned spins = 0;
+    while (Atomic$load(&counter->pending))
+    {
+        Job *job = JobSystem$find();
+        if (job)
+        {
+            Job$execute(job);
+            spins = 0;
+        }
+        else if (++spins < JOB_SPIN_COUNT)
+        {
+            Atomic$pause();
+        }
+        else
+        {
+            Thread$yield();
+        }
+    }
+
+    // Wait for the thread that finished the last job to let go of the counter
+    SpinLock$lock(&counter->lock);
+    SpinLock$unlock(&counter->lock);
+}
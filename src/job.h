@@ -0,0 +1,47 @@
+////////////////////////////////////////////
+// File    : job.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "rtti.h"
+#include "sync.h"
+
+typedef struct Job Job;
+typedef struct JobCounter JobCounter;
+typedef void (*JobFunc)(void *data);
+
+// Most arguments a Member job can be given
+#define JOB_MAX_ARGS 4
+
+// Starts the worker threads. 0 picks one fewer than the number of
+// cores, leaving a core for the thread that waits on the jobs.
+void     JobSystem$start(unsigned worker_count);
+// Waits for the workers to finish whatever they are running and joins
+// them. Jobs still queued, and any jobs those queue, are then run on the
+// calling thread, so every counter reaches zero before it returns.
+void     JobSystem$stop(void);
+unsigned JobSystem$worker_count(void);
+
+// Queue func(data). counter, if given, counts the job until it finishes.
+void Job$run(JobFunc func, void *data, JobCounter *counter);
+// Queue func(data) to run once after has dropped to zero
+void Job$run_after(JobCounter *after, JobFunc func, void *data, JobCounter *counter);
+// Queue a Member invocation on self, which must outlive the job.
+// The job takes ownership of the args, and the result is freed.
+void Job$run_member(Any *self, const Member *member, unsigned arg_count,
+                    Any *args, JobCounter *counter);
+
+// Runs queued jobs on this thread until counter drops to zero, so any
+// thread, workers included, can wait without wasting its core
+void JobCounter$wait(JobCounter *counter);
+
+#define JOB_COUNTER_INIT { 0, SPINLOCK_INIT, NULL }
+struct JobCounter
+{
+    volatile intptr_t pending; // Jobs queued or running
+    SpinLock lock; // Guards waiting
+    Job *waiting; // Jobs queued with Job$run_after
+};
@@ -10,17 +10,17 @@ void string_rtti_test()
 
     // Append a value
     Any value = Any$from_cstr("Cool!");
-    Any$invoke(str, "append", 1, &value);
+    Any$invoke_in_place(&str, "append", 1, &value);
 
     // Print it out
-    puts(Any$invoke(str, "cstr", 0, NULL).value.cstr);
+    puts(Any$invoke_in_place(&str, "cstr", 0, NULL).value.cstr);
 
     // Prepend a value
     value = Any$from_cstr("You Are ");
-    Any$invoke(str, "prepend", 1, &value);
+    Any$invoke_in_place(&str, "prepend", 1, &value);
 
     // Print it out
-    puts(Any$invoke(str, "cstr", 0, NULL).value.cstr);
+    puts(Any$invoke_in_place(&str, "cstr", 0, NULL).value.cstr);
 
     // Free the str
     Any$free(&str);
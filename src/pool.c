@@ -0,0 +1,248 @@
+////////////////////////////////////////////
+// File    : pool.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "pool.h"
+#include "rtti.h"
+#include "sync.h"
+#include "hash.h"
+#include <stdlib.h>
+#include <assert.h>
+
+// Blocks are handed out in multiples of this, which is also
+// the alignment every block is guaranteed to have
+#define POOL_GRANULARITY 16
+// Anything bigger than this goes straight to malloc
+#define POOL_MAX_SIZE 1024
+#define POOL_CLASS_COUNT (POOL_MAX_SIZE / POOL_GRANULARITY)
+// Blocks moved between a thread cache and its shared pool at a time
+#define POOL_BATCH 64
+// Bytes carved up for a size class when its shared pool runs dry
+#define POOL_SLAB_SIZE (64 * 1024)
+// Types with live and peak counts, past this they are not counted
+#define POOL_STATS_SLOTS 1024
+#define POOL_CACHE_LINE 64
+
+typedef struct PoolBlock PoolBlock;
+typedef struct PoolClass PoolClass;
+typedef struct PoolCache PoolCache;
+typedef struct PoolTypeStats PoolTypeStats;
+
+struct PoolBlock
+{
+    PoolBlock *next;
+};
+
+// Shared free list for one size class
+struct PoolClass
+{
+    SpinLock lock;
+    PoolBlock *free_list;
+};
+
+// Per-thread free list for one size class
+struct PoolCache
+{
+    PoolBlock *head;
+    unsigned count;
+};
+
+// Counts for one type. They are kept out of Type so boxing never writes
+// to metadata every thread reads, and each gets its own cache line so
+// only threads boxing the same type touch the same one.
+struct PoolTypeStats
+{
+    const Type *volatile type; // NULL while the slot is free
+    volatile intptr_t live;
+    volatile intptr_t peak;
+    char padding[POOL_CACHE_LINE - 3 * sizeof(intptr_t)];
+};
+
+static PoolClass pool_classes[POOL_CLASS_COUNT];
+static THREAD_LOCAL PoolCache pool_caches[POOL_CLASS_COUNT];
+static PoolTypeStats pool_stats[POOL_STATS_SLOTS];
+
+static bool Pool$is_pooled(const Type *type)
+{
+    return type->size <= POOL_MAX_SIZE && type->alignment <= POOL_GRANULARITY;
+}
+
+static unsigned Pool$class_index(const Type *type)
+{
+    unsigned size = type->size ? type->size : 1;
+    return (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY - 1;
+}
+
+// Finds the counts for type, claiming a slot if insert is set.
+// NULL if the type has none, or the table is full.
+static PoolTypeStats *Pool$type_stats(const Type *type, bool insert)
+{
+    size_t start = (size_t)Hash$mix((uint64_t)(uintptr_t)type);
+    for (size_t i = 0; i < POOL_STATS_SLOTS; ++i)
+    {
+        PoolTypeStats *entry = &pool_stats[(start + i) & (POOL_STATS_SLOTS - 1)];
+        void *volatile *slot = (void *volatile *)&entry->type;
+        const Type *current = (const Type *)Atomic$load_ptr(slot);
+        if (!current && insert && !Atomic$cas_ptr(slot, NULL, (void *)type))
+        {
+            // Someone else claimed it first, maybe for this type
+            current = (const Type *)Atomic$load_ptr(slot);
+        }
+        else if (!current)
+        {
+            return insert ? entry : NULL;
+        }
+
+        if (current == type)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void Pool$refill(unsigned class_index, PoolCache *cache)
+{
+    PoolClass *pool = &pool_classes[class_index];
+
+    SpinLock$lock(&pool->lock);
+
+    // Take a batch from the shared list if it has one
+    while (pool->free_list && cache->count < POOL_BATCH)
+    {
+        PoolBlock *block = pool->free_list;
+        pool->free_list = block->next;
+        block->next = cache->head;
+        cache->head = block;
+        cache->count++;
+    }
+
+    SpinLock$unlock(&pool->lock);
+
+    if (cache->head)
+    {
+        return;
+    }
+
+    // Otherwise carve a new slab straight into the cache. Slabs are
+    // never given back to the system, the blocks just get recycled.
+    size_t block_size = (class_index + 1) * POOL_GRANULARITY;
+    size_t block_count = POOL_SLAB_SIZE / block_size;
+    char *slab = malloc(block_count * block_size);
+    assert(slab && "Uh oh, failed to allocate memory!");
+
+    for (size_t i = 0; i < block_count; ++i)
+    {
+        PoolBlock *block = (PoolBlock *)(slab + i * block_size);
+        block->next = cache->head;
+        cache->head = block;
+    }
+    cache->count += (unsigned)block_count;
+}
+
+static void Pool$spill(unsigned class_index, PoolCache *cache, unsigned keep)
+{
+    PoolClass *pool = &pool_classes[class_index];
+    if (cache->count <= keep)
+    {
+        return;
+    }
+
+    // Unlink the excess first so the lock is only held for the splice
+    PoolBlock *first = cache->head;
+    PoolBlock *last = first;
+    for (unsigned i = 1; i < cache->count - keep; ++i)
+    {
+        last = last->next;
+    }
+    cache->head = last->next;
+    cache->count = keep;
+
+    SpinLock$lock(&pool->lock);
+    last->next = pool->free_list;
+    pool->free_list = first;
+    SpinLock$unlock(&pool->lock);
+}
+
+void *Pool$alloc(const Type *type)
+{
+    PoolTypeStats *stats = Pool$type_stats(type, true);
+    if (stats)
+    {
+        Atomic$max(&stats->peak, Atomic$add(&stats->live, 1));
+    }
+
+    if (!Pool$is_pooled(type))
+    {
+        void *storage = malloc(type->size);
+        assert(storage && "Uh oh, failed to allocate memory!");
+        return storage;
+    }
+
+    unsigned class_index = Pool$class_index(type);
+    PoolCache *cache = &pool_caches[class_index];
+    if (!cache->head)
+    {
+        Pool$refill(class_index, cache);
+    }
+
+    PoolBlock *block = cache->head;
+    cache->head = block->next;
+    cache->count--;
+    return block;
+}
+
+void Pool$free(const Type *type, void *ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    PoolTypeStats *stats = Pool$type_stats(type, false);
+    if (stats)
+    {
+        Atomic$add(&stats->live, -1);
+    }
+
+    if (!Pool$is_pooled(type))
+    {
+        free(ptr);
+        return;
+    }
+
+    unsigned class_index = Pool$class_index(type);
+    PoolCache *cache = &pool_caches[class_index];
+    PoolBlock *block = (PoolBlock *)ptr;
+    block->next = cache->head;
+    cache->head = block;
+    cache->count++;
+
+    // Don't let one thread hoard everything it has freed
+    if (cache->count > POOL_BATCH * 2)
+    {
+        Pool$spill(class_index, cache, POOL_BATCH);
+    }
+}
+
+void Pool$flush_thread(void)
+{
+    for (unsigned i = 0; i < POOL_CLASS_COUNT; ++i)
+    {
+        Pool$spill(i, &pool_caches[i], 0);
+    }
+}
+
+PoolStats Pool$stats(const Type *type)
+{
+    PoolStats result = { 0, 0 };
+    PoolTypeStats *stats = Pool$type_stats(type, false);
+    if (stats)
+    {
+        result.live = (size_t)Atomic$load(&stats->live);
+        result.peak = (size_t)Atomic$load(&stats->peak);
+    }
+    return result;
+}
@@ -0,0 +1,32 @@
+////////////////////////////////////////////
+// File    : pool.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stddef.h>
+
+struct Type;
+
+typedef struct PoolStats PoolStats;
+
+// Allocate storage for one boxed value of the given type
+void *Pool$alloc(const struct Type *type);
+// Free storage from Pool$alloc, type must be the one it was allocated for
+void  Pool$free(const struct Type *type, void *ptr);
+// Hand this thread's cached blocks back to the shared pools.
+// Call it before a thread exits or they are lost.
+void  Pool$flush_thread(void);
+
+// Counts values boxed through the pool, which is every heap boxing.
+// Values stored inline in an Any, in an arena or in another Allocator
+// never reach the pool, so they aren't included.
+PoolStats Pool$stats(const struct Type *type);
+
+struct PoolStats
+{
+    size_t live; // Boxed values currently allocated
+    size_t peak; // Most boxed values allocated at once
+};
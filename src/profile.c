@@ -0,0 +1,423 @@
+////////////////////////////////////////////
+// File    : profile.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "profile.h"
+#include "rtti.h"
+#include "pool.h"
+#include "sync.h"
+#include "hash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+uint64_t Profile$now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+    if (!frequency.QuadPart)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+bool Profile$enabled(void)
+{
+#ifdef RTTI_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Nothing below is compiled in without RTTI_PROFILE
+#ifdef RTTI_PROFILE
+
+// Slots in the table mapping Types and Members to their ids
+#define PROFILE_ID_SLOTS 4096
+
+typedef struct ProfileTypeCounters ProfileTypeCounters;
+typedef struct ProfileMemberCounters ProfileMemberCounters;
+typedef struct ProfileThread ProfileThread;
+typedef struct ProfileIdSlot ProfileIdSlot;
+
+struct ProfileTypeCounters
+{
+    uint64_t boxings;
+    uint64_t frees;
+    uint64_t bytes;
+};
+
+struct ProfileMemberCounters
+{
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+};
+
+// Written only by its thread. Blocks are never freed so the
+// counters of threads that have exited still show up in reports.
+struct ProfileThread
+{
+    ProfileThread *next;
+    ProfileTypeCounters types[PROFILE_MAX_TYPES];
+    ProfileMemberCounters members[PROFILE_MAX_MEMBERS];
+};
+
+// Ids are kept here rather than on the Types and Members, so their
+// layout doesn't depend on RTTI_PROFILE. Slots are filled under
+// profile_lock, with the id written before the object is published.
+struct ProfileIdSlot
+{
+    const void *volatile object;
+    intptr_t id; // Index into profile_types or profile_members, or -1
+};
+
+// Ids index these
+static SpinLock profile_lock = SPINLOCK_INIT;
+static const Type *profile_types[PROFILE_MAX_TYPES];
+static const Member *profile_members[PROFILE_MAX_MEMBERS];
+static volatile intptr_t profile_type_count;
+static volatile intptr_t profile_member_count;
+static ProfileThread *profile_threads;
+static ProfileIdSlot profile_ids[PROFILE_ID_SLOTS];
+
+static THREAD_LOCAL ProfileThread *profile_thread;
+
+static ProfileThread *Profile$get_thread(void)
+{
+    if (!profile_thread)
+    {
+        ProfileThread *thread = (ProfileThread *)calloc(1, sizeof(ProfileThread));
+        assert(thread && "Uh oh, failed to allocate memory!");
+
+        SpinLock$lock(&profile_lock);
+        thread->next = profile_threads;
+        profile_threads = thread;
+        SpinLock$unlock(&profile_lock);
+
+        profile_thread = thread;
+    }
+    return profile_thread;
+}
+
+// Finds the slot holding object, or the empty one it would go in.
+// NULL if the table is full.
+static ProfileIdSlot *Profile$find_slot(const void *object)
+{
+    size_t start = (size_t)Hash$mix((uint64_t)(uintptr_t)object);
+    for (size_t i = 0; i < PROFILE_ID_SLOTS; ++i)
+    {
+        ProfileIdSlot *slot = &profile_ids[(start + i) & (PROFILE_ID_SLOTS - 1)];
+        const void *current = Atomic$load_ptr((void *volatile *)&slot->object);
+        if (!current || current == object)
+        {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+// Returns the index for the object, or -1 once the table is full.
+// Objects that didn't fit are remembered with -1 so they aren't retried.
+static intptr_t Profile$assign_id(const void **table, volatile intptr_t *count,
+                                  intptr_t capacity, const void *object)
+{
+    ProfileIdSlot *slot = Profile$find_slot(object);
+    if (slot && Atomic$load_ptr((void *volatile *)&slot->object) == object)
+    {
+        return slot->id;
+    }
+
+    SpinLock$lock(&profile_lock);
+
+    // Look again, another thread may have added it in the meantime
+    intptr_t id = -1;
+    slot = Profile$find_slot(object);
+    if (slot && slot->object == object)
+    {
+        id = slot->id;
+    }
+    else
+    {
+        if (*count < capacity)
+        {
+            id = *count;
+            table[id] = object;
+            Atomic$store(count, id + 1);
+        }
+        if (slot)
+        {
+            slot->id = id;
+            Atomic$store_ptr((void *volatile *)&slot->object, (void *)object);
+        }
+    }
+
+    SpinLock$unlock(&profile_lock);
+    return id;
+}
+
+static intptr_t Profile$type_id(const Type *type)
+{
+    return Profile$assign_id((const void **)profile_types, &profile_type_count,
+                             PROFILE_MAX_TYPES, type);
+}
+
+static intptr_t Profile$member_id(const Member *member)
+{
+    return Profile$assign_id((const void **)profile_members, &profile_member_count,
+                             PROFILE_MAX_MEMBERS, member);
+}
+
+void Profile$box(const Type *type, size_t bytes)
+{
+    intptr_t id = Profile$type_id(type);
+    if (id < 0)
+    {
+        return;
+    }
+
+    ProfileTypeCounters *counters = &Profile$get_thread()->types[id];
+    counters->boxings++;
+    counters->bytes += bytes;
+}
+
+void Profile$free(const Type *type)
+{
+    intptr_t id = Profile$type_id(type);
+    if (id < 0)
+    {
+        return;
+    }
+
+    Profile$get_thread()->types[id].frees++;
+}
+
+void Profile$invoke(const Member *member, uint64_t elapsed_ns)
+{
+    intptr_t id = Profile$member_id(member);
+    if (id < 0)
+    {
+        return;
+    }
+
+    ProfileMemberCounters *counters = &Profile$get_thread()->members[id];
+    counters->calls++;
+    counters->total_ns += elapsed_ns;
+    if (elapsed_ns > counters->max_ns)
+    {
+        counters->max_ns = elapsed_ns;
+    }
+}
+
+static int Profile$compare_types(const void *lhs, const void *rhs)
+{
+    const TypeProfile *a = (const TypeProfile *)lhs;
+    const TypeProfile *b = (const TypeProfile *)rhs;
+    if (a->bytes != b->bytes)
+    {
+        return a->bytes < b->bytes ? 1 : -1;
+    }
+    if (a->boxings != b->boxings)
+    {
+        return a->boxings < b->boxings ? 1 : -1;
+    }
+    return 0;
+}
+
+static int Profile$compare_members(const void *lhs, const void *rhs)
+{
+    const MemberProfile *a = (const MemberProfile *)lhs;
+    const MemberProfile *b = (const MemberProfile *)rhs;
+    if (a->total_ns != b->total_ns)
+    {
+        return a->total_ns < b->total_ns ? 1 : -1;
+    }
+    return 0;
+}
+
+unsigned Profile$types(TypeProfile *out, unsigned max)
+{
+    static TypeProfile all[PROFILE_MAX_TYPES];
+    unsigned count = (unsigned)Atomic$load(&profile_type_count);
+
+    SpinLock$lock(&profile_lock);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        TypeProfile *profile = &all[i];
+        memset(profile, 0, sizeof(TypeProfile));
+        profile->type = profile_types[i];
+
+        for (ProfileThread *thread = profile_threads; thread; thread = thread->next)
+        {
+            profile->boxings += thread->types[i].boxings;
+            profile->frees += thread->types[i].frees;
+            profile->bytes += thread->types[i].bytes;
+        }
+
+        profile->live = (int64_t)(profile->boxings - profile->frees);
+        profile->peak = Pool$stats(profile->type).peak;
+    }
+
+    qsort(all, count, sizeof(TypeProfile), Profile$compare_types);
+    if (count > max)
+    {
+        count = max;
+    }
+    memcpy(out, all, count * sizeof(TypeProfile));
+    SpinLock$unlock(&profile_lock);
+
+    return count;
+}
+
+unsigned Profile$members(MemberProfile *out, unsigned max)
+{
+    static MemberProfile all[PROFILE_MAX_MEMBERS];
+    unsigned count = (unsigned)Atomic$load(&profile_member_count);
+
+    SpinLock$lock(&profile_lock);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        MemberProfile *profile = &all[i];
+        memset(profile, 0, sizeof(MemberProfile));
+        profile->member = profile_members[i];
+
+        for (ProfileThread *thread = profile_threads; thread; thread = thread->next)
+        {
+            const ProfileMemberCounters *counters = &thread->members[i];
+            profile->calls += counters->calls;
+            profile->total_ns += counters->total_ns;
+            if (counters->max_ns > profile->max_ns)
+            {
+                profile->max_ns = counters->max_ns;
+            }
+        }
+    }
+
+    qsort(all, count, sizeof(MemberProfile), Profile$compare_members);
+    if (count > max)
+    {
+        count = max;
+    }
+    memcpy(out, all, count * sizeof(MemberProfile));
+    SpinLock$unlock(&profile_lock);
+
+    return count;
+}
+
+// Finds the type a member belongs to, just for the report
+static const char *Profile$owner_name(const Member *member)
+{
+    for (intptr_t i = 0; i < profile_type_count; ++i)
+    {
+        const Type *type = profile_types[i];
+        if (type->constructor == member || type->destructor == member)
+        {
+            return type->name;
+        }
+        for (unsigned m = 0; m < type->member_count; ++m)
+        {
+            if (type->members[m] == member)
+            {
+                return type->name;
+            }
+        }
+    }
+    return "?";
+}
+
+void Profile$report(FILE *stream)
+{
+    static TypeProfile types[PROFILE_MAX_TYPES];
+    static MemberProfile members[PROFILE_MAX_MEMBERS];
+
+    unsigned type_count = Profile$types(types, PROFILE_MAX_TYPES);
+    fprintf(stream, "%-24s %12s %12s %12s %10s %10s\n",
+            "type", "boxings", "frees", "bytes", "live", "peak");
+    for (unsigned i = 0; i < type_count; ++i)
+    {
+        const TypeProfile *profile = &types[i];
+        fprintf(stream, "%-24s %12llu %12llu %12llu %10lld %10llu\n",
+                profile->type->name,
+                (unsigned long long)profile->boxings,
+                (unsigned long long)profile->frees,
+                (unsigned long long)profile->bytes,
+                (long long)profile->live,
+                (unsigned long long)profile->peak);
+    }
+
+    unsigned member_count = Profile$members(members, PROFILE_MAX_MEMBERS);
+    fprintf(stream, "\n%-32s %12s %14s %12s %12s\n",
+            "member", "calls", "total ns", "avg ns", "max ns");
+    for (unsigned i = 0; i < member_count; ++i)
+    {
+        const MemberProfile *profile = &members[i];
+        char name[64];
+        const char *member_name = profile->member->name ? profile->member->name : "";
+        snprintf(name, sizeof(name), member_name[0] == '.' ? "%s%s" : "%s.%s",
+                 Profile$owner_name(profile->member), member_name);
+        fprintf(stream, "%-32s %12llu %14llu %12llu %12llu\n",
+                name,
+                (unsigned long long)profile->calls,
+                (unsigned long long)profile->total_ns,
+                (unsigned long long)(profile->calls ? profile->total_ns / profile->calls : 0),
+                (unsigned long long)profile->max_ns);
+    }
+}
+
+void Profile$reset(void)
+{
+    SpinLock$lock(&profile_lock);
+    for (ProfileThread *thread = profile_threads; thread; thread = thread->next)
+    {
+        memset(thread->types, 0, sizeof(thread->types));
+        memset(thread->members, 0, sizeof(thread->members));
+    }
+    SpinLock$unlock(&profile_lock);
+}
+
+#else
+
+unsigned Profile$types(TypeProfile *out, unsigned max)
+{
+    (out); (max); // unreferenced parameters
+    return 0;
+}
+
+unsigned Profile$members(MemberProfile *out, unsigned max)
+{
+    (out); (max); // unreferenced parameters
+    return 0;
+}
+
+void Profile$report(FILE *stream)
+{
+    fprintf(stream, "Profiling is off, build with RTTI_PROFILE defined\n");
+}
+
+void Profile$reset(void)
+{
+}
+
+#endif
@@ -0,0 +1,85 @@
+////////////////////////////////////////////
+// File    : profile.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+struct Type;
+struct Member;
+
+typedef struct TypeProfile TypeProfile;
+typedef struct MemberProfile MemberProfile;
+
+/////////////////////////////////////
+// Recording hooks
+//
+// Define RTTI_PROFILE when building rtti.c and profile.c to count
+// boxings and frees per Type and time every Member$invoke. Counters
+// live in a block owned by the recording thread, so recording never
+// takes a lock or an atomic. Without RTTI_PROFILE the hooks expand to
+// nothing, none of the counters exist, and the reports below come
+// back empty. Type and Member look the same either way.
+
+#ifdef RTTI_PROFILE
+#define PROFILE_BOX(type, bytes) Profile$box(type, bytes)
+#define PROFILE_FREE(type) Profile$free(type)
+#define PROFILE_INVOKE_BEGIN(start) uint64_t start = Profile$now_ns()
+#define PROFILE_INVOKE_END(member, start) Profile$invoke(member, Profile$now_ns() - (start))
+#else
+#define PROFILE_BOX(type, bytes) ((void)0)
+#define PROFILE_FREE(type) ((void)0)
+#define PROFILE_INVOKE_BEGIN(start) ((void)0)
+#define PROFILE_INVOKE_END(member, start) ((void)0)
+#endif
+
+// Types and members past these limits are not recorded
+#define PROFILE_MAX_TYPES 256
+#define PROFILE_MAX_MEMBERS 1024
+
+uint64_t Profile$now_ns(void);
+#ifdef RTTI_PROFILE
+// bytes is what the value took off the heap or an arena, 0 when stored inline
+void Profile$box(const struct Type *type, size_t bytes);
+void Profile$free(const struct Type *type);
+void Profile$invoke(const struct Member *member, uint64_t elapsed_ns);
+#endif
+
+/////////////////////////////////////
+// Reports
+//
+// Counters from every thread are summed. Threads still recording
+// may be caught mid-update, so stop them first for exact numbers.
+
+// Whether this build records anything
+bool Profile$enabled(void);
+// Fill out with up to max entries, most bytes first. Returns the count.
+unsigned Profile$types(TypeProfile *out, unsigned max);
+// Fill out with up to max entries, most total time first. Returns the count.
+unsigned Profile$members(MemberProfile *out, unsigned max);
+void Profile$report(FILE *stream);
+// Zero every counter, which is only safe while no thread is recording
+void Profile$reset(void);
+
+struct TypeProfile
+{
+    const struct Type *type;
+    uint64_t boxings; // Complex Anys created
+    uint64_t frees; // Owned complex Anys freed or released
+    uint64_t bytes; // Heap and arena bytes taken by boxings
+    int64_t live; // boxings - frees
+    size_t peak; // Most heap boxed values at once, from Pool$stats
+};
+
+struct MemberProfile
+{
+    const struct Member *member;
+    uint64_t calls;
+    uint64_t total_ns; // Includes members it invoked in turn
+    uint64_t max_ns;
+};
@@ -7,41 +7,365 @@
 #include "rtti.h"
 #include "helpers.h"
 #include "string.h"
+#include "pool.h"
+#include "arena.h"
+#include "allocator.h"
+#include "hash.h"
+#include "intern.h"
+#include "writer.h"
+#include "profile.h"
+#include "sync.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
-const Field *Type$find_field(const Type *this, const char *name)
+/////////////////////////////////////
+// Name lookup tables
+
+// Types smaller than this are scanned directly, hashing the
+// name costs more than a handful of strcmps
+#define INDEX_MIN_COUNT 8
+
+// Most arguments Member$invoke_batch can lend out per call
+#define MEMBER_BATCH_MAX_ARGS 16
+
+typedef struct IndexSlot IndexSlot;
+
+struct IndexSlot
+{
+    uint32_t hash;
+    unsigned position; // Position in the list + 1, 0 marks an empty slot
+    Atom atom; // Interned name, for Type$find_field_atom and Type$find_member_atom
+};
+
+struct TypeIndex
+{
+    uint32_t field_mask;
+    uint32_t member_mask;
+    IndexSlot *field_slots;
+    IndexSlot *member_slots;
+};
+
+static uint32_t Type$hash_name(const char *name)
+{
+    // Matches the hash interned names carry, so atoms never need hashing
+    return (uint32_t)Hash$bytes(name, strlen(name));
+}
+
+static uint32_t Type$index_size(unsigned count)
+{
+    // Keep the table at most half full so probes stay short,
+    // and always leave at least one empty slot to end a probe
+    uint32_t size = 1;
+    while (size < count * 2)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+static void Type$index_insert(IndexSlot *slots, uint32_t mask,
+                              const char *const *names, unsigned position)
+{
+    // Names are interned as the index is built
+    Atom atom = Intern$cstr(names[position]);
+    uint32_t hash = (uint32_t)Intern$hash(atom);
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        IndexSlot *slot = &slots[i];
+        if (!slot->position)
+        {
+            slot->hash = hash;
+            slot->position = position + 1;
+            slot->atom = atom;
+            return;
+        }
+
+        // Duplicate names resolve to the first entry, same as a linear scan
+        if (slot->atom == atom)
+        {
+            return;
+        }
+    }
+}
+
+static const TypeIndex *Type$get_index(const Type *this)
 {
+    // Types are shared statics, so the index is cached on them even
+    // through a const pointer. The acquire load pairs with the CAS below,
+    // so a published index is always seen with its tables filled in.
+    void *volatile *cached = (void *volatile *)&((Type *)this)->index;
+    const TypeIndex *published = (const TypeIndex *)Atomic$load_ptr(cached);
+    if (published)
+    {
+        return published;
+    }
+
+    uint32_t field_size = Type$index_size(this->field_count);
+    uint32_t member_size = Type$index_size(this->member_count);
+    unsigned name_count = this->field_count > this->member_count
+        ? this->field_count
+        : this->member_count;
+
+    // The index and both tables live in one allocation
+    size_t bytes = sizeof(TypeIndex) + (field_size + member_size) * sizeof(IndexSlot);
+    TypeIndex *index = calloc(1, bytes);
+    const char **names = malloc((name_count ? name_count : 1) * sizeof(const char *));
+    assert(index && names && "Uh oh, failed to allocate memory!");
+
+    index->field_mask = field_size - 1;
+    index->member_mask = member_size - 1;
+    index->field_slots = (IndexSlot *)(index + 1);
+    index->member_slots = index->field_slots + field_size;
+
+    for (unsigned i = 0; i < this->field_count; ++i)
+    {
+        names[i] = this->fields[i]->name;
+    }
     for (unsigned i = 0; i < this->field_count; ++i)
     {
-        const Field *field = this->fields[i];
-        if (strcmp(field->name, name) == 0)
+        Type$index_insert(index->field_slots, index->field_mask, names, i);
+    }
+
+    for (unsigned i = 0; i < this->member_count; ++i)
+    {
+        names[i] = this->members[i]->name;
+    }
+    for (unsigned i = 0; i < this->member_count; ++i)
+    {
+        Type$index_insert(index->member_slots, index->member_mask, names, i);
+    }
+
+    free(names);
+
+    // Two threads racing here both build equivalent tables,
+    // and the loser frees its copy and uses the winner's
+    if (!Atomic$cas_ptr(cached, NULL, index))
+    {
+        free(index);
+        return (const TypeIndex *)Atomic$load_ptr(cached);
+    }
+    return index;
+}
+
+const Field *Type$find_field(const Type *this, const char *name)
+{
+    if (this->field_count < INDEX_MIN_COUNT)
+    {
+        for (unsigned i = 0; i < this->field_count; ++i)
         {
-            return field;
+            const Field *field = this->fields[i];
+            if (strcmp(field->name, name) == 0)
+            {
+                return field;
+            }
         }
+
+        return NULL;
     }
 
-    return NULL;
+    const TypeIndex *index = Type$get_index(this);
+    uint32_t hash = Type$hash_name(name);
+
+    for (uint32_t i = hash & index->field_mask;; i = (i + 1) & index->field_mask)
+    {
+        const IndexSlot *slot = &index->field_slots[i];
+        if (!slot->position)
+        {
+            return NULL;
+        }
+
+        if (slot->hash == hash)
+        {
+            const Field *field = this->fields[slot->position - 1];
+            if (strcmp(field->name, name) == 0)
+            {
+                return field;
+            }
+        }
+    }
 }
 
 const Member *Type$find_member(const Type *this, const char *name)
 {
-    for (unsigned i = 0; i < this->member_count; ++i)
+    if (this->member_count < INDEX_MIN_COUNT)
+    {
+        for (unsigned i = 0; i < this->member_count; ++i)
+        {
+            const Member *member = this->members[i];
+            if (strcmp(member->name, name) == 0)
+            {
+                return member;
+            }
+        }
+
+        return NULL;
+    }
+
+    const TypeIndex *index = Type$get_index(this);
+    uint32_t hash = Type$hash_name(name);
+
+    for (uint32_t i = hash & index->member_mask;; i = (i + 1) & index->member_mask)
     {
-        const Member *member = this->members[i];
-        if (strcmp(member->name, name) == 0)
+        const IndexSlot *slot = &index->member_slots[i];
+        if (!slot->position)
         {
-            return member;
+            return NULL;
         }
+
+        if (slot->hash == hash)
+        {
+            const Member *member = this->members[slot->position - 1];
+            if (strcmp(member->name, name) == 0)
+            {
+                return member;
+            }
+        }
+    }
+}
+
+const Field *Type$find_field_atom(const Type *this, const char *name)
+{
+    const TypeIndex *index = Type$get_index(this);
+    uint32_t hash = (uint32_t)Intern$hash(name);
+
+    for (uint32_t i = hash & index->field_mask;; i = (i + 1) & index->field_mask)
+    {
+        const IndexSlot *slot = &index->field_slots[i];
+        if (!slot->position)
+        {
+            return NULL;
+        }
+
+        if (slot->atom == name)
+        {
+            return this->fields[slot->position - 1];
+        }
+    }
+}
+
+const Member *Type$find_member_atom(const Type *this, const char *name)
+{
+    const TypeIndex *index = Type$get_index(this);
+    uint32_t hash = (uint32_t)Intern$hash(name);
+
+    for (uint32_t i = hash & index->member_mask;; i = (i + 1) & index->member_mask)
+    {
+        const IndexSlot *slot = &index->member_slots[i];
+        if (!slot->position)
+        {
+            return NULL;
+        }
+
+        if (slot->atom == name)
+        {
+            return this->members[slot->position - 1];
+        }
+    }
+}
+
+size_t Type$hash_value(const Type *this, const void *value)
+{
+    if (this->hash)
+    {
+        return this->hash(value);
+    }
+
+    // Most keys are a single word, which only needs mixing
+    if (this->size <= sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, value, this->size);
+        return (size_t)Hash$mix(word);
+    }
+    return (size_t)Hash$bytes(value, this->size);
+}
+
+bool Type$equal_values(const Type *this, const void *lhs, const void *rhs)
+{
+    if (this->equals)
+    {
+        return this->equals(lhs, rhs);
     }
+    return memcmp(lhs, rhs, this->size) == 0;
+}
+
+#define COMPARE_AS(T) \
+    { T l = *(const T *)lhs, r = *(const T *)rhs; return (l > r) - (l < r); }
+
+int Type$compare_values(const Type *this, const void *lhs, const void *rhs)
+{
+    if (this->kind == TK_COMPLEX)
+    {
+        const Member *cmp = Type$find_member(this, ".cmp");
+        assert(cmp && "Type has no .cmp member to order it with");
+
+        Any other = Any$ref_complex(this, (void *)rhs);
+        Any result = Member$invoke(cmp, (void *)lhs, 1, &other);
+        return result.value.i32;
+    }
+
+    if (this == &type_cstr)
+    {
+        int result = strcmp(*(const char *const *)lhs, *(const char *const *)rhs);
+        return (result > 0) - (result < 0);
+    }
+
+    if (this == &type_int8_t) COMPARE_AS(int8_t)
+    if (this == &type_int16_t) COMPARE_AS(int16_t)
+    if (this == &type_int32_t) COMPARE_AS(int32_t)
+    if (this == &type_int64_t) COMPARE_AS(int64_t)
+    if (this == &type_float) COMPARE_AS(float)
+    if (this == &type_double) COMPARE_AS(double)
+
+    // Everything else is unsigned, including pointers
+    switch (this->size)
+    {
+        case 1: COMPARE_AS(uint8_t)
+        case 2: COMPARE_AS(uint16_t)
+        case 4: COMPARE_AS(uint32_t)
+        case 8: COMPARE_AS(uint64_t)
+        default: return memcmp(lhs, rhs, this->size);
+    }
+}
+
+bool Type$has_traits(const Type *this, unsigned traits)
+{
+    unsigned has = this->traits;
+    if (this->kind != TK_COMPLEX)
+    {
+        has = this->equals ? TT_POD & ~TT_BITWISE_EQUAL : TT_POD;
+    }
+    return (has & traits) == traits;
+}
 
-    return NULL;
+void Type$copy_value(const Type *this, void *placement, const void *value)
+{
+    if (Type$has_traits(this, TT_TRIVIAL_COPY))
+    {
+        memcpy(placement, value, this->size);
+        return;
+    }
+
+    Any copy = Any$copy(Any$ref_complex(this, (void *)value));
+    memcpy(placement, Any$data(&copy), this->size);
+    Any$soft_release(&copy);
+}
+
+void Type$destroy_value(const Type *this, void *value)
+{
+    if (!Type$has_traits(this, TT_TRIVIAL_DESTROY))
+    {
+        Any obj = Any$ref_complex(this, value);
+        Any$delete_ref(&obj);
+    }
 }
 
 const Any Member$invoke(const Member *this, void *obj, unsigned arg_count, Any *args)
 {
+    PROFILE_INVOKE_BEGIN(start);
     Any result = this->invoke(obj, arg_count, args);
+    PROFILE_INVOKE_END(this, start);
 
     // Clean up unused arguments
     for (unsigned i = 0; i < arg_count; ++i)
@@ -53,6 +377,61 @@ const Any Member$invoke(const Member *this, void *obj, unsigned arg_count, Any *
     return result;
 }
 
+// Lends a value to one call. A member that takes ownership of a
+// borrowed complex value copies it instead, leaving the original alone.
+static Any Any$borrow(const Any *arg)
+{
+    if (arg->type && arg->type->kind == TK_COMPLEX && arg->storage != AS_REF)
+    {
+        return Any$ref_complex(arg->type, Any$data(arg));
+    }
+    return *arg;
+}
+
+void Member$invoke_batch(const Member *this, void *objects, size_t stride, size_t count,
+                         unsigned arg_count, Any *args, Any *results)
+{
+    // A whole batch is profiled as one call
+    PROFILE_INVOKE_BEGIN(start);
+    if (this->invoke_batch)
+    {
+        this->invoke_batch(objects, stride, count, arg_count, args, results);
+    }
+    else
+    {
+        Any borrowed[MEMBER_BATCH_MAX_ARGS];
+        assert(arg_count <= MEMBER_BATCH_MAX_ARGS && "Too many arguments for a batch");
+
+        char *obj = (char *)objects;
+        for (size_t i = 0; i < count; ++i, obj += stride)
+        {
+            // Lent again every call, since members may overwrite their arguments
+            for (unsigned a = 0; a < arg_count; ++a)
+            {
+                borrowed[a] = Any$borrow(&args[a]);
+            }
+
+            Any result = this->invoke(obj, arg_count, borrowed);
+            if (results)
+            {
+                results[i] = result;
+            }
+            else
+            {
+                Any$free(&result);
+            }
+        }
+    }
+    PROFILE_INVOKE_END(this, start);
+
+    for (unsigned i = 0; i < arg_count; ++i)
+    {
+        Any$free(&args[i]);
+    }
+}
+
+static Any Any$alloc_complex(const Type *type);
+
 Any Any$make_default(const Type *type)
 {
     if (type == NULL)
@@ -73,6 +452,13 @@ Any Any$make_default(const Type *type)
         }
         case TK_COMPLEX:
         {
+            if (Type$has_traits(type, TT_ZERO_INIT))
+            {
+                Any result = Any$alloc_complex(type);
+                memset(Any$data(&result), 0, type->size);
+                return result;
+            }
+
             // Call the default constructor
             return Member$invoke(type->constructor, NULL, 0, NULL);
         }
@@ -120,7 +506,7 @@ Any Any$from_int32(int32_t i)
 
 Any Any$from_uint32(uint32_t u)
 {
-    Any result = { &type_uint8_t };
+    Any result = { &type_uint32_t };
     result.value.u32 = u;
     return result;
 }
@@ -169,34 +555,76 @@ Any Any$from_cstr(const char *cstr)
     return result;
 }
 
+Any Any$from_type(const Type *type)
+{
+    Any result = { &type_type_ptr };
+    result.value.ptr = (void *)type;
+    return result;
+}
+
+static bool Any$fits_inline(const Type *type)
+{
+    return type->size <= ANY_INLINE_SIZE && type->alignment <= sizeof(void *);
+}
+
+// An owned complex Any with uninitialized storage for the value
+static Any Any$alloc_complex(const Type *type)
+{
+    Any result = { type };
+    if (Any$fits_inline(type))
+    {
+        // Small enough to skip the heap entirely
+        result.storage = AS_INLINE;
+        PROFILE_BOX(type, 0);
+        return result;
+    }
+
+    PROFILE_BOX(type, type->size);
+
+    // Temporaries made during an arena scope die with the scope
+    Arena *arena = Arena$active();
+    if (arena)
+    {
+        result.storage = AS_ARENA;
+        result.value.ptr = Arena$alloc_object(arena, type);
+        return result;
+    }
+
+    // The pool is the heap's fast path, anything else is asked directly
+    Allocator *allocator = Allocator$current();
+    if (allocator != &Allocator$heap)
+    {
+        result.storage = AS_ALLOCATED;
+        result.value.allocated.ptr = Allocator$alloc(allocator, type->size, type->alignment);
+        result.value.allocated.allocator = allocator;
+        return result;
+    }
+
+    result.storage = AS_BOXED;
+    result.value.ptr = Pool$alloc(type);
+    return result;
+}
+
 Any Any$from_complex(const Type *type, void *value)
 {
     switch (type->kind)
     {
         case TK_PRIMITIVE:
         {
-            Any result;
-            result.type = type;
+            Any result = { type };
             memcpy(&result.value, value, type->size);
             return result;
         }
         case TK_POINTER:
         {
-            Any result;
-            result.type = type;
+            Any result = { type };
             result.value.ptr = value;
             return result;
         }
         case TK_COMPLEX:
         {
-            Any result;
-            void *storage = malloc(type->size);
-
-            assert(storage && "Uh oh, failed to allocate memory!");
-            memcpy(storage, value, type->size);
-
-            result.type = type;
-            result.value.ptr = storage;
+            Any result = Any$alloc_complex(type);
+            memcpy(Any$data(&result), value, type->size);
             return result;
         }
         case TK_VOID:
@@ -209,8 +637,8 @@ Any Any$from_complex(const Type *type, void *value)
 
 Any Any$ref_complex(const Type *type, void *value)
 {
-    Any any;
-    any.type = type;
+    Any any = { type };
+    any.storage = AS_REF;
     any.value.ptr = value;
     return any;
 }
@@ -226,7 +654,15 @@ Any Any$copy(Any obj)
     {
         case TK_COMPLEX:
         {
-            return Member$invoke(obj.type->constructor, obj.value.ptr, 1, &obj);
+            if (Type$has_traits(obj.type, TT_TRIVIAL_COPY))
+            {
+                return Any$from_complex(obj.type, Any$data(&obj));
+            }
+
+            // Pass a reference so the constructor copies instead of
+            // taking ownership of the original
+            Any source = Any$ref_complex(obj.type, Any$data(&obj));
+            return Member$invoke(obj.type->constructor, NULL, 1, &source);
         }
         case TK_VOID:
         case TK_PRIMITIVE:
@@ -238,27 +674,87 @@ Any Any$copy(Any obj)
     }
 }
 
+void *Any$data(const Any *boxed)
+{
+    if (!boxed->type)
+    {
+        return NULL;
+    }
+
+    if (boxed->storage == AS_REF)
+    {
+        return boxed->value.ptr;
+    }
+
+    switch (boxed->type->kind)
+    {
+        case TK_COMPLEX:
+        {
+            if (boxed->storage == AS_INLINE)
+            {
+                return (void *)boxed->value.bytes;
+            }
+            return boxed->value.ptr;
+        }
+        case TK_POINTER:
+        {
+            return boxed->value.ptr;
+        }
+        case TK_VOID:
+        case TK_PRIMITIVE:
+        default:
+        {
+            return (void *)&boxed->value;
+        }
+    }
+}
+
 void Any$unpack(Any boxed, void *placement)
 {
     switch (boxed.type->kind)
     {
         case TK_COMPLEX:
         {
-            memcpy(placement, boxed.value.ptr, boxed.type->size);
+            memcpy(placement, Any$data(&boxed), boxed.type->size);
+            break;
         }
         default:
         {
             memcpy(placement, &boxed.value, boxed.type->size);
+            break;
         }
     }
 }
 
+// Gives heap storage back to where it came from, without destroying the value
+static void Any$release_storage(Any *boxed)
+{
+    if (boxed->storage == AS_BOXED)
+    {
+        Pool$free(boxed->type, boxed->value.ptr);
+    }
+    else if (boxed->storage == AS_ALLOCATED)
+    {
+        Allocator$free(boxed->value.allocated.allocator, boxed->value.allocated.ptr,
+                       boxed->type->size);
+    }
+}
+
 void Any$free(Any *boxed)
 {
-    if (boxed->type && boxed->type->kind == TK_COMPLEX)
+    if (boxed->type && boxed->type->kind == TK_COMPLEX && boxed->storage != AS_REF)
     {
-        Member$invoke(boxed->type->destructor, boxed->value.ptr, 0, NULL);
-        free(boxed->value.ptr);
+        PROFILE_FREE(boxed->type);
+
+        // Arena values are destroyed when their arena is reset
+        if (boxed->storage != AS_ARENA)
+        {
+            if (!Type$has_traits(boxed->type, TT_TRIVIAL_DESTROY))
+            {
+                Member$invoke(boxed->type->destructor, Any$data(boxed), 0, NULL);
+            }
+            Any$release_storage(boxed);
+        }
     }
     *boxed = Any$EMPTY;
 }
@@ -272,33 +768,94 @@ void Any$soft_release(Any *boxed)
 {
     if (boxed->type && boxed->type->kind == TK_COMPLEX)
     {
-        free(boxed->value.ptr);
+        if (boxed->storage != AS_REF)
+        {
+            PROFILE_FREE(boxed->type);
+        }
+        if (boxed->storage == AS_BOXED || boxed->storage == AS_ALLOCATED)
+        {
+            Any$release_storage(boxed);
+        }
+        else if (boxed->storage == AS_ARENA)
+        {
+            Arena$release_object(boxed->type, boxed->value.ptr);
+        }
     }
     *boxed = Any$EMPTY;
 }
 
 void Any$delete_ref(Any *boxed)
 {
-    if (boxed->type && boxed->type->kind == TK_COMPLEX)
+    if (boxed->type && boxed->type->kind == TK_COMPLEX &&
+        !Type$has_traits(boxed->type, TT_TRIVIAL_DESTROY))
     {
-        Member$invoke(boxed->type->destructor, boxed->value.ptr, 0, NULL);
+        Member$invoke(boxed->type->destructor, Any$data(boxed), 0, NULL);
     }
     *boxed = Any$EMPTY;
 }
 
 Any Any$invoke(Any self, const char *member_name, unsigned arg_count, Any *args)
 {
-    if (!self.type) { return Any$EMPTY; }
-    const Member *member = Type$find_member(self.type, member_name);
+    return Any$invoke_in_place(&self, member_name, arg_count, args);
+}
+
+Any Any$invoke_in_place(Any *self, const char *member_name, unsigned arg_count, Any *args)
+{
+    if (!self->type) { return Any$EMPTY; }
+    const Member *member = Type$find_member(self->type, member_name);
     if (!member) { return Any$EMPTY; }
-    return Member$invoke(member, self.value.ptr, arg_count, args);
+    return Member$invoke(member, Any$data(self), arg_count, args);
 }
 
+Any Any$invoke_member(Any *self, const Member *member, unsigned arg_count, Any *args)
+{
+    if (!self->type || !member) { return Any$EMPTY; }
+    return Member$invoke(member, Any$data(self), arg_count, args);
+}
+
+Any Any$invoke_cached(Any *self, InvokeCache *cache, unsigned arg_count, Any *args)
+{
+    if (!self->type) { return Any$EMPTY; }
+    const Member *member = InvokeCache$resolve(cache, self->type);
+    if (!member) { return Any$EMPTY; }
+    return Member$invoke(member, Any$data(self), arg_count, args);
+}
+
+const Member *InvokeCache$resolve(InvokeCache *this, const Type *type)
+{
+    // Most call sites only ever see one type, so check the slots in order
+    for (unsigned i = 0; i < INVOKE_CACHE_WAYS; ++i)
+    {
+        if (this->types[i] == type)
+        {
+            return this->members[i];
+        }
+    }
+
+    // Miss, do the real lookup and replace the oldest entry
+    const Member *member = Type$find_member(type, this->member_name);
+    unsigned slot = this->next_slot;
+    this->types[slot] = type;
+    this->members[slot] = member;
+    this->next_slot = (slot + 1) % INVOKE_CACHE_WAYS;
+    return member;
+}
+
+static void Any$write_opaque(Any obj, Writer *writer);
+
 void Any$print(Any obj, FILE *stream)
+{
+    char buffer[256];
+    Writer writer = Writer$to_file(stream, buffer, sizeof(buffer));
+    Any$write(obj, &writer);
+    Writer$close(&writer);
+}
+
+void Any$write(Any obj, Writer *writer)
 {
     if (!obj.type)
     {
-        fputs("Any$EMPTY", stream);
+        Writer$cstr(writer, "Any$EMPTY");
         return;
     }
 
@@ -306,58 +863,58 @@ void Any$print(Any obj, FILE *stream)
     {
         case TK_VOID:
         {
-            fputs("void", stream);
+            Writer$cstr(writer, "void");
             return;
         }
         case TK_PRIMITIVE:
         {
             if (obj.type == &type_int8_t)
             {
-                fprintf(stream, "%I32d", (int32_t)obj.value.i8);
+                Writer$int(writer, obj.value.i8);
             }
             else if (obj.type == &type_uint8_t)
             {
-                fprintf(stream, "%I32u", (uint32_t)obj.value.u8);
+                Writer$uint(writer, obj.value.u8);
             }
             else if (obj.type == &type_int16_t)
             {
-                fprintf(stream, "%I32d", (int32_t)obj.value.i16);
+                Writer$int(writer, obj.value.i16);
             }
             else if (obj.type == &type_uint16_t)
             {
-                fprintf(stream, "%I32u", (uint32_t)obj.value.u16);
+                Writer$uint(writer, obj.value.u16);
             }
             else if (obj.type == &type_int32_t)
             {
-                fprintf(stream, "%I32d", obj.value.i32);
+                Writer$int(writer, obj.value.i32);
             }
             else if (obj.type == &type_uint32_t)
             {
-                fprintf(stream, "%I32u", obj.value.u32);
+                Writer$uint(writer, obj.value.u32);
             }
             else if (obj.type == &type_int64_t)
             {
-                fprintf(stream, "%I64d", obj.value.i64);
+                Writer$int(writer, obj.value.i64);
             }
             else if (obj.type == &type_uint64_t)
             {
-                fprintf(stream, "%I64u", obj.value.u64);
+                Writer$uint(writer, obj.value.u64);
             }
-            else if (obj.type == &type_float)
+            else if (obj.type == &type_size_t)
             {
-                fprintf(stream, "%f", obj.value.f32);
+                Writer$uint(writer, sizeof(size_t) == 8 ? obj.value.u64 : obj.value.u32);
             }
-            else if (obj.type == &type_double)
+            else if (obj.type == &type_float)
             {
-                fprintf(stream, "%f", obj.value.f64);
+                Writer$float(writer, obj.value.f32);
             }
-            else if (obj.type == &type_cstr)
+            else if (obj.type == &type_double)
             {
-                fputs(obj.value.cstr, stream);
+                Writer$double(writer, obj.value.f64);
             }
             else
             {
-                fprintf(stream, "#<%s:0x%p>", obj.type->name, obj.value.ptr);
+                Any$write_opaque(obj, writer);
             }
             return;
         }
@@ -366,18 +923,33 @@ void Any$print(Any obj, FILE *stream)
         {
             if (obj.type == &type_string || obj.type == &type_string_ptr)
             {
-                fprintf(stream, "\"%s\"", String$cstr((const String *)obj.value.ptr));
-                return;
+                Writer$char(writer, '"');
+                Writer$string(writer, *(const String *)Any$data(&obj));
+                Writer$char(writer, '"');
+            }
+            else if (obj.type == &type_cstr)
+            {
+                Writer$cstr(writer, obj.value.cstr);
             }
             else
             {
-                fprintf(stream, "#<%s:0x%p>", obj.type->name, obj.value.ptr);
-                return;
+                Any$write_opaque(obj, writer);
             }
+            return;
         }
     }
 }
 
+// #<Type:0x1234abcd>
+static void Any$write_opaque(Any obj, Writer *writer)
+{
+    Writer$cstr(writer, "#<");
+    Writer$cstr(writer, obj.type->name);
+    Writer$char(writer, ':');
+    Writer$pointer(writer, obj.type->kind == TK_COMPLEX ? Any$data(&obj) : obj.value.ptr);
+    Writer$char(writer, '>');
+}
+
 #define DEF_PRIMITIVE(T) { TK_PRIMITIVE, sizeof(T), sizeof(T), #T }
 Type type_void = { TK_VOID, 0, 0, "void" };
 Type type_int8_t = DEF_PRIMITIVE(int8_t);
@@ -395,14 +967,44 @@ Type type_size_t = DEF_PRIMITIVE(uint32_t);
 #endif
 Type type_float = DEF_PRIMITIVE(float);
 Type type_double = DEF_PRIMITIVE(double);
-Type type_cstr = { TK_POINTER, sizeof(const char *), sizeof(const char *), "cstr" };
+
+// cstrs are keyed by their contents, not their address
+static size_t cstr_hash(const void *value)
+{
+    const char *cstr = *(const char *const *)value;
+    return (size_t)Hash$bytes(cstr, strlen(cstr));
+}
+
+static bool cstr_equals(const void *lhs, const void *rhs)
+{
+    return strcmp(*(const char *const *)lhs, *(const char *const *)rhs) == 0;
+}
+
+Type type_cstr =
+{
+    TK_POINTER,
+    sizeof(const char *),
+    sizeof(const char *),
+    "cstr",
+    NULL,
+    NULL, NULL, // No constructor or destructor
+    0, NULL, // Fields
+    0, NULL, // Members
+    0, NULL, // Interfaces
+    cstr_hash,
+    cstr_equals,
+};
+
+Type type_type_ptr = { TK_POINTER, sizeof(Type *), sizeof(Type *), "Type*" };
 
 static Any any_ctor(void *this, unsigned arg_count, Any *args)
 {
     (this); // unused
     if (arg_count)
     {
-        Any copy = Any$copy(args[0]);
+        // Copying an Any copies the value held inside of it
+        Any source = args[0].type == &type_any ? *(Any *)Any$data(&args[0]) : args[0];
+        Any copy = Any$copy(source);
         return Any$from_complex(&type_any, &copy);
     }
     else
@@ -411,7 +1013,7 @@ static Any any_ctor(void *this, unsigned arg_count, Any *args)
     }
 }
 
-static Type *any_ctor_args[] =
+static const Type *any_ctor_args[] =
 {
     &type_any,
 };
@@ -444,6 +1046,39 @@ static Member any_dtor_member =
     false, // overloaded
 };
 
+// Anys hash and compare the values they hold
+static size_t any_hash(const void *value)
+{
+    const Any *any = (const Any *)value;
+    if (!any->type)
+    {
+        return 0;
+    }
+
+    const void *data = any->type->kind == TK_COMPLEX ? Any$data(any) : &any->value;
+    return Type$hash_value(any->type, data) ^ (size_t)Hash$mix((uintptr_t)any->type);
+}
+
+static bool any_equals(const void *lhs, const void *rhs)
+{
+    const Any *l = (const Any *)lhs;
+    const Any *r = (const Any *)rhs;
+    if (l->type != r->type)
+    {
+        return false;
+    }
+    if (!l->type)
+    {
+        return true;
+    }
+
+    if (l->type->kind == TK_COMPLEX)
+    {
+        return Type$equal_values(l->type, Any$data(l), Any$data(r));
+    }
+    return Type$equal_values(l->type, &l->value, &r->value);
+}
+
 static const Member *any_member_list[] =
 {
     &any_ctor_member,
@@ -463,6 +1098,9 @@ Type type_any =
     0, NULL, // Fields
     ARRAY_SIZE(any_member_list), any_member_list,
     0, NULL, // Interfaces
+    any_hash,
+    any_equals,
+    TT_ZERO_INIT, // Any$EMPTY is all zeros
 };
 
 Any Any$EMPTY = { NULL };
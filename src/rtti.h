@@ -13,18 +13,48 @@
 /////////////////////////////////////
 // Type declarations
 typedef enum TypeKind TypeKind;
+typedef enum TypeTraits TypeTraits;
+typedef enum AnyStorage AnyStorage;
 typedef struct Type Type;
 typedef struct Interface Interface;
 typedef struct Field Field;
 typedef struct Member Member;
 typedef struct Any Any;
+typedef struct TypeIndex TypeIndex;
+typedef struct InvokeCache InvokeCache;
+struct Writer;
+struct Allocator;
 
 /////////////////////////////////////
 // Type manipulation functions
 const Field *Type$find_field(const Type *this, const char *name);
 const Member *Type$find_member(const Type *this, const char *name);
+// Same as above, but name must be an Atom from intern.h. Names
+// are compared by pointer, so this never touches the characters.
+const Field *Type$find_field_atom(const Type *this, const char *name);
+const Member *Type$find_member_atom(const Type *this, const char *name);
+// Uses the type's hash and equals hooks if it has them,
+// otherwise the value is hashed and compared byte for byte
+size_t Type$hash_value(const Type *this, const void *value);
+bool Type$equal_values(const Type *this, const void *lhs, const void *rhs);
+// Orders primitives by value and cstrs with strcmp. Complex types are ordered
+// by their ".cmp" member, which takes the other value and returns an int32_t.
+int Type$compare_values(const Type *this, const void *lhs, const void *rhs);
+// Whether the type has every one of the given TypeTraits flags.
+// Primitives and pointers have all of them, except that types with
+// an equals hook are never TT_BITWISE_EQUAL.
+bool Type$has_traits(const Type *this, unsigned traits);
+// Copy constructs value into placement, a memcpy for trivially copyable types
+void Type$copy_value(const Type *this, void *placement, const void *value);
+// Destroys the value in place, leaving its storage alone
+void Type$destroy_value(const Type *this, void *value);
 
 const Any Member$invoke(const Member *this, void *obj, unsigned arg_count, Any *args);
+// Invokes the member on count objects laid out stride bytes apart, such as the
+// elements of a Vector. Every call shares args, which are freed once at the end.
+// results is NULL to discard them, otherwise it gets one result per object.
+void Member$invoke_batch(const Member *this, void *objects, size_t stride, size_t count,
+                         unsigned arg_count, Any *args, Any *results);
 
 Any Any$make_default(const Type *type);
 Any Any$from_int8(int8_t i);
@@ -41,17 +71,30 @@ Any Any$from_double(double d);
 // You need to make sure the string will live as long as the Any value is needed
 // Construct a String value if you are unsure
 Any Any$from_cstr(const char *cstr);
+Any Any$from_type(const Type *type);
 // Note that this function takes ownership of the value
 Any Any$from_complex(const Type *type, void *value);
 Any Any$ref_complex(const Type *type, void *value);
 Any Any$copy(Any obj);
+// Where the value lives, i.e. the object pointer members are invoked on.
+// Inline values live inside the Any, so the pointer dies with it.
+void *Any$data(const Any *boxed);
 void Any$unpack(Any boxed, void *placement);
 void Any$free(Any *boxed);
 void Any$freev(Any boxed);
 void Any$soft_release(Any *boxed);
 void Any$delete_ref(Any *boxed);
+// Works on a copy of self, so members that modify a value stored inline
+// in the Any only change the copy. Use Any$invoke_in_place for those.
 Any Any$invoke(Any self, const char *member_name, unsigned arg_count, Any *args);
+// self is taken by pointer so inline values are modified in place
+Any Any$invoke_in_place(Any *self, const char *member_name, unsigned arg_count, Any *args);
+// Invoke a member resolved ahead of time with Type$find_member
+Any Any$invoke_member(Any *self, const Member *member, unsigned arg_count, Any *args);
+// Invoke through a call-site cache, only looking the name up on a miss
+Any Any$invoke_cached(Any *self, InvokeCache *cache, unsigned arg_count, Any *args);
 void Any$print(Any obj, FILE *stream);
+void Any$write(Any obj, struct Writer *writer);
 
 /////////////////////////////////////
 // Type types
@@ -63,6 +106,17 @@ enum TypeKind
     TK_COMPLEX,
 };
 
+// Lets containers replace per-element reflective calls with block operations
+enum TypeTraits
+{
+    TT_TRIVIAL_COPY = 1 << 0, // Copying is a memcpy, the constructor is never needed
+    TT_TRIVIAL_DESTROY = 1 << 1, // Destroying does nothing, the destructor is never needed
+    TT_ZERO_INIT = 1 << 2, // All zero bytes is the default value
+    TT_BITWISE_EQUAL = 1 << 3, // Equal values have identical bytes
+
+    TT_POD = TT_TRIVIAL_COPY | TT_TRIVIAL_DESTROY | TT_ZERO_INIT | TT_BITWISE_EQUAL,
+};
+
 struct Type
 {
     TypeKind kind;
@@ -82,6 +136,14 @@ struct Type
 
     unsigned interface_count;
     const Interface **interfaces;
+
+    // Optional, for types that can't be hashed or compared as plain bytes
+    size_t (*hash)(const void *value);
+    bool (*equals)(const void *lhs, const void *rhs);
+    unsigned traits; // TypeTraits, only read for complex types
+
+    // Runtime data, built lazily. Leave this zeroed in type definitions.
+    TypeIndex *index; // Hashed name lookup for fields and members
 };
 
 struct Interface
@@ -110,6 +172,53 @@ struct Member
     const Type *return_type; // Return type of the function
     bool is_static; // Whether obj needs to be set to an instance
     bool is_overloaded; // Whether fewer args than the maximum can be given
+
+    // Optional, used by Member$invoke_batch in place of calling invoke per object.
+    // args are borrowed, and results may be NULL.
+    void(*invoke_batch)(void *objects, size_t stride, size_t count,
+                        unsigned arg_count, Any *arguments, Any *results);
+};
+
+/////////////////////////////////////
+// Call-site caches
+
+// Number of types a single call site remembers before it
+// starts evicting entries
+#define INVOKE_CACHE_WAYS 4
+
+// Declare one per call site. Resolving updates the slots without any
+// synchronization, so a cache must only ever be used by one thread.
+// A plain static is shared by every thread that runs the call site,
+// so make it thread-local with THREAD_LOCAL from sync.h:
+//   static THREAD_LOCAL InvokeCache cache = INVOKE_CACHE("append");
+#define INVOKE_CACHE(member_name) { member_name }
+
+const Member *InvokeCache$resolve(InvokeCache *this, const Type *type);
+
+struct InvokeCache
+{
+    const char *member_name;
+    unsigned next_slot; // Slot replaced on the next miss
+    const Type *types[INVOKE_CACHE_WAYS];
+    const Member *members[INVOKE_CACHE_WAYS]; // NULL caches a failed lookup
+};
+
+/////////////////////////////////////
+// Any types
+
+// Complex values up to this size are stored inside the Any instead
+// of on the heap. Must be at least sizeof(void *).
+#ifndef ANY_INLINE_SIZE
+#define ANY_INLINE_SIZE (3 * sizeof(void *))
+#endif
+
+enum AnyStorage
+{
+    AS_BOXED, // value.ptr is owned by the Any
+    AS_INLINE, // The value is stored in value.bytes
+    AS_REF, // value.ptr is borrowed, freeing the Any leaves it alone
+    AS_ARENA, // value.ptr is owned by an Arena, which destroys it on reset
+    AS_ALLOCATED, // value.ptr is owned by the Any, and came from value.allocated.allocator
 };
 
 union AnyData
@@ -126,11 +235,14 @@ union AnyData
     double f64;
     void *ptr;
     const char *cstr;
+    struct { void *ptr; struct Allocator *allocator; } allocated; // ptr aliases value.ptr
+    unsigned char bytes[ANY_INLINE_SIZE];
 };
 
 struct Any
 {
     const Type *type;
+    AnyStorage storage; // Only meaningful for complex values
     union AnyData value;
 };
 
@@ -149,6 +261,7 @@ extern Type type_size_t;
 extern Type type_float;
 extern Type type_double;
 extern Type type_cstr;
+extern Type type_type_ptr;
 extern Type type_any;
 
 /////////////////////////////////////
@@ -0,0 +1,778 @@
+////////////////////////////////////////////
+// File    : serialize.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "serialize.h"
+#include "rtti.h"
+#include "string.h"
+#include "vector.h"
+#include "hashmap.h"
+#include "arena.h"
+#include "sync.h"
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+// "GSNP", then the format version
+#define SERIAL_MAGIC 0x504E5347u
+#define SERIAL_VERSION 1u
+
+// Writes smaller than this are gathered before going to the stream
+#define SERIAL_BUFFER_SIZE (64 * 1024)
+// Deepest nesting of values, so bad snapshots can't blow the stack
+#define SERIAL_MAX_DEPTH 1024
+// Length written for a NULL cstr
+#define SERIAL_NULL_CSTR UINT64_MAX
+
+typedef struct SerialWriter SerialWriter;
+typedef struct SerialReader SerialReader;
+
+struct SerialWriter
+{
+    FILE *stream;
+    unsigned char *buffer;
+    size_t used;
+    uint64_t offset; // Bytes written so far, blocks are aligned relative to the start
+    bool ok;
+    unsigned depth;
+    HashMap type_ids; // const Type * -> uint32_t
+    Vector types; // const Type *, in id order
+};
+
+struct SerialReader
+{
+    const unsigned char *data;
+    const unsigned char *pos;
+    const unsigned char *end;
+    struct Arena *arena;
+    const Type **types; // Registered type for each schema id
+    uint32_t type_count;
+    bool ok;
+    unsigned depth;
+};
+
+/////////////////////////////////////
+// Type registry
+
+static HashMap serial_registry; // cstr -> const Type *
+static bool serial_registry_ready = false;
+static SpinLock serial_registry_lock = SPINLOCK_INIT;
+
+static void Serial$register_locked(const Type *type)
+{
+    const char *name = type->name;
+    const Type *const *existing = HashMap$get(&serial_registry, &name);
+    if (existing)
+    {
+        return;
+    }
+
+    const Type *value = type;
+    HashMap$insert(&serial_registry, &name, &value);
+
+    if (type->kind == TK_COMPLEX)
+    {
+        for (unsigned i = 0; i < type->field_count; ++i)
+        {
+            Serial$register_locked(type->fields[i]->type);
+        }
+    }
+}
+
+static void Serial$lock_registry(void)
+{
+    SpinLock$lock(&serial_registry_lock);
+    if (!serial_registry_ready)
+    {
+        static const Type *builtins[] =
+        {
+            &type_int8_t, &type_uint8_t, &type_int16_t, &type_uint16_t,
+            &type_int32_t, &type_uint32_t, &type_int64_t, &type_uint64_t,
+            &type_float, &type_double, &type_cstr, &type_string, &type_vector,
+        };
+
+        serial_registry = HashMap$new(&type_cstr, &type_type_ptr);
+        for (size_t i = 0; i < sizeof(builtins) / sizeof(builtins[0]); ++i)
+        {
+            Serial$register_locked(builtins[i]);
+        }
+        serial_registry_ready = true;
+    }
+}
+
+void Serial$register(const Type *type)
+{
+    Serial$lock_registry();
+    Serial$register_locked(type);
+    SpinLock$unlock(&serial_registry_lock);
+}
+
+const Type *Serial$find_type(const char *name)
+{
+    Serial$lock_registry();
+    const Type *const *found = HashMap$get(&serial_registry, &name);
+    const Type *type = found ? *found : NULL;
+    SpinLock$unlock(&serial_registry_lock);
+    return type;
+}
+
+/////////////////////////////////////
+// Layouts
+
+// Plain data is saved and loaded as its raw bytes
+static bool Serial$is_plain(const Type *type)
+{
+    if (type->kind == TK_PRIMITIVE)
+    {
+        return true;
+    }
+    if (type->kind != TK_COMPLEX || !type->field_count ||
+        !Type$has_traits(type, TT_TRIVIAL_COPY | TT_TRIVIAL_DESTROY))
+    {
+        return false;
+    }
+
+    for (unsigned i = 0; i < type->field_count; ++i)
+    {
+        const Field *field = type->fields[i];
+        if (field->is_pointer || !Serial$is_plain(field->type))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Separate descriptors can stand for the same primitive, like size_t
+static bool Serial$same_type(const Type *lhs, const Type *rhs)
+{
+    return lhs == rhs || (lhs->kind == TK_PRIMITIVE && rhs->kind == TK_PRIMITIVE &&
+                          lhs->size == rhs->size && strcmp(lhs->name, rhs->name) == 0);
+}
+
+/////////////////////////////////////
+// Writing
+
+static void SerialWriter$flush(SerialWriter *this)
+{
+    if (this->used && fwrite(this->buffer, 1, this->used, this->stream) != this->used)
+    {
+        this->ok = false;
+    }
+    this->used = 0;
+}
+
+static void SerialWriter$bytes(SerialWriter *this, const void *data, size_t size)
+{
+    this->offset += size;
+    if (this->used + size > SERIAL_BUFFER_SIZE)
+    {
+        SerialWriter$flush(this);
+    }
+
+    // Big blocks skip the buffer entirely
+    if (size >= SERIAL_BUFFER_SIZE)
+    {
+        if (fwrite(data, 1, size, this->stream) != size)
+        {
+            this->ok = false;
+        }
+        return;
+    }
+
+    if (size)
+    {
+        memcpy(this->buffer + this->used, data, size);
+        this->used += size;
+    }
+}
+
+static void SerialWriter$u8(SerialWriter *this, uint8_t value)
+{
+    SerialWriter$bytes(this, &value, sizeof(value));
+}
+
+static void SerialWriter$u32(SerialWriter *this, uint32_t value)
+{
+    SerialWriter$bytes(this, &value, sizeof(value));
+}
+
+static void SerialWriter$u64(SerialWriter *this, uint64_t value)
+{
+    SerialWriter$bytes(this, &value, sizeof(value));
+}
+
+// Length, characters and a NUL, so loads can use the characters in place
+static void SerialWriter$chars(SerialWriter *this, const char *chars, size_t len)
+{
+    SerialWriter$u64(this, len);
+    SerialWriter$bytes(this, chars, len);
+    SerialWriter$u8(this, 0);
+}
+
+static void SerialWriter$align(SerialWriter *this, size_t alignment)
+{
+    static const unsigned char zeroes[64] = { 0 };
+    size_t padding = (size_t)(alignment - this->offset % alignment) % alignment;
+    while (padding)
+    {
+        size_t chunk = padding < sizeof(zeroes) ? padding : sizeof(zeroes);
+        SerialWriter$bytes(this, zeroes, chunk);
+        padding -= chunk;
+    }
+}
+
+static void SerialWriter$collect_type(SerialWriter *this, const Type *type)
+{
+    if (HashMap$contains(&this->type_ids, &type))
+    {
+        return;
+    }
+
+    uint32_t id = (uint32_t)this->types.len;
+    const Type *key = type;
+    HashMap$insert(&this->type_ids, &key, &id);
+    Vector$push(&this->types, &key);
+
+    if (type->kind == TK_COMPLEX)
+    {
+        for (unsigned i = 0; i < type->field_count; ++i)
+        {
+            SerialWriter$collect_type(this, type->fields[i]->type);
+        }
+    }
+}
+
+// Vector element types are only known at runtime,
+// so the value is walked to find all of them
+static void SerialWriter$collect_value(SerialWriter *this, const Type *type, const void *value)
+{
+    SerialWriter$collect_type(this, type);
+    if (Serial$is_plain(type) || this->depth >= SERIAL_MAX_DEPTH)
+    {
+        return;
+    }
+
+    this->depth++;
+    if (type == &type_vector)
+    {
+        const Vector *vec = (const Vector *)value;
+        SerialWriter$collect_type(this, vec->member_type);
+        if (!Serial$is_plain(vec->member_type))
+        {
+            for (size_t i = 0; i < vec->len; ++i)
+            {
+                SerialWriter$collect_value(this, vec->member_type,
+                                           (const char *)vec->data + i * vec->member_type->size);
+            }
+        }
+    }
+    else if (type->kind == TK_COMPLEX)
+    {
+        for (unsigned i = 0; i < type->field_count; ++i)
+        {
+            const Field *field = type->fields[i];
+            const void *field_value = (const char *)value + field->struct_offset;
+            if (field->is_pointer)
+            {
+                field_value = *(const void *const *)field_value;
+                if (!field_value)
+                {
+                    continue;
+                }
+            }
+            SerialWriter$collect_value(this, field->type, field_value);
+        }
+    }
+    this->depth--;
+}
+
+static uint32_t SerialWriter$type_id(const SerialWriter *this, const Type *type)
+{
+    return *(const uint32_t *)HashMap$get(&this->type_ids, &type);
+}
+
+static void SerialWriter$schema(SerialWriter *this)
+{
+    SerialWriter$u32(this, (uint32_t)this->types.len);
+    for (size_t i = 0; i < this->types.len; ++i)
+    {
+        const Type *type = ((const Type **)this->types.data)[i];
+        SerialWriter$chars(this, type->name, strlen(type->name));
+        SerialWriter$u8(this, (uint8_t)type->kind);
+        SerialWriter$u32(this, type->size);
+        SerialWriter$u32(this, type->alignment);
+
+        unsigned field_count = type->kind == TK_COMPLEX ? type->field_count : 0;
+        SerialWriter$u32(this, field_count);
+        for (unsigned f = 0; f < field_count; ++f)
+        {
+            const Field *field = type->fields[f];
+            SerialWriter$chars(this, field->name, strlen(field->name));
+            SerialWriter$u32(this, SerialWriter$type_id(this, field->type));
+            SerialWriter$u32(this, field->struct_offset);
+            SerialWriter$u8(this, field->is_pointer);
+        }
+    }
+}
+
+static void SerialWriter$value(SerialWriter *this, const Type *type, const void *value)
+{
+    if (Serial$is_plain(type))
+    {
+        SerialWriter$bytes(this, value, type->size);
+        return;
+    }
+    if (this->depth >= SERIAL_MAX_DEPTH)
+    {
+        this->ok = false;
+        return;
+    }
+
+    this->depth++;
+    if (type == &type_cstr)
+    {
+        const char *cstr = *(const char *const *)value;
+        if (cstr)
+        {
+            SerialWriter$chars(this, cstr, strlen(cstr));
+        }
+        else
+        {
+            SerialWriter$u64(this, SERIAL_NULL_CSTR);
+        }
+    }
+    else if (type == &type_string)
+    {
+        const String *str = (const String *)value;
+        SerialWriter$chars(this, String$cstr(str), String$len(str));
+    }
+    else if (type == &type_vector)
+    {
+        const Vector *vec = (const Vector *)value;
+        const Type *member_type = vec->member_type;
+        SerialWriter$u32(this, SerialWriter$type_id(this, member_type));
+        SerialWriter$u64(this, vec->len);
+
+        if (Serial$is_plain(member_type))
+        {
+            SerialWriter$align(this, member_type->alignment);
+            SerialWriter$bytes(this, vec->data, vec->len * member_type->size);
+        }
+        else
+        {
+            for (size_t i = 0; i < vec->len && this->ok; ++i)
+            {
+                SerialWriter$value(this, member_type, (const char *)vec->data + i * member_type->size);
+            }
+        }
+    }
+    else if (type->kind == TK_COMPLEX && type->field_count)
+    {
+        for (unsigned i = 0; i < type->field_count; ++i)
+        {
+            const Field *field = type->fields[i];
+            const void *field_value = (const char *)value + field->struct_offset;
+            if (field->is_pointer)
+            {
+                field_value = *(const void *const *)field_value;
+                SerialWriter$u8(this, field_value != NULL);
+                if (!field_value)
+                {
+                    continue;
+                }
+            }
+            SerialWriter$value(this, field->type, field_value);
+        }
+    }
+    else
+    {
+        // Other pointers, and complex types without fields
+        this->ok = false;
+    }
+    this->depth--;
+}
+
+bool Serial$save(FILE *stream, const Type *type, const void *value)
+{
+    SerialWriter writer = { stream };
+    writer.buffer = malloc(SERIAL_BUFFER_SIZE);
+    assert(writer.buffer && "Uh oh, failed to allocate memory!");
+    writer.ok = true;
+    writer.type_ids = HashMap$new(&type_type_ptr, &type_uint32_t);
+    writer.types = Vector$new(&type_type_ptr);
+
+    SerialWriter$collect_value(&writer, type, value);
+
+    SerialWriter$u32(&writer, SERIAL_MAGIC);
+    SerialWriter$u32(&writer, SERIAL_VERSION);
+    SerialWriter$schema(&writer);
+    SerialWriter$u32(&writer, SerialWriter$type_id(&writer, type));
+    SerialWriter$value(&writer, type, value);
+    SerialWriter$flush(&writer);
+
+    Vector$free(&writer.types);
+    HashMap$free(&writer.type_ids);
+    free(writer.buffer);
+    return writer.ok;
+}
+
+bool Serial$save_file(const char *path, const Type *type, const void *value)
+{
+    FILE *stream = fopen(path, "wb");
+    if (!stream)
+    {
+        return false;
+    }
+
+    bool ok = Serial$save(stream, type, value);
+    if (fclose(stream) != 0)
+    {
+        ok = false;
+    }
+    return ok;
+}
+
+/////////////////////////////////////
+// Reading
+
+// Pointer to the next size bytes, or NULL if the snapshot is too short
+static const unsigned char *SerialReader$take(SerialReader *this, uint64_t size)
+{
+    if (!this->ok || size > (uint64_t)(this->end - this->pos))
+    {
+        this->ok = false;
+        return NULL;
+    }
+
+    const unsigned char *data = this->pos;
+    this->pos += size;
+    return data;
+}
+
+static uint8_t SerialReader$u8(SerialReader *this)
+{
+    const unsigned char *data = SerialReader$take(this, 1);
+    return data ? data[0] : 0;
+}
+
+static uint32_t SerialReader$u32(SerialReader *this)
+{
+    uint32_t value = 0;
+    const unsigned char *data = SerialReader$take(this, sizeof(value));
+    if (data)
+    {
+        memcpy(&value, data, sizeof(value));
+    }
+    return value;
+}
+
+static uint64_t SerialReader$u64(SerialReader *this)
+{
+    uint64_t value = 0;
+    const unsigned char *data = SerialReader$take(this, sizeof(value));
+    if (data)
+    {
+        memcpy(&value, data, sizeof(value));
+    }
+    return value;
+}
+
+// Characters written by SerialWriter$chars, used in place
+static const char *SerialReader$chars(SerialReader *this, uint64_t len)
+{
+    if (len >= (uint64_t)(this->end - this->pos))
+    {
+        this->ok = false;
+        return NULL;
+    }
+
+    const char *chars = (const char *)SerialReader$take(this, len + 1);
+    if (chars && chars[len] != '\0')
+    {
+        this->ok = false;
+    }
+    return this->ok ? chars : NULL;
+}
+
+static const Type *SerialReader$type(SerialReader *this, uint32_t id)
+{
+    if (id >= this->type_count)
+    {
+        this->ok = false;
+        return NULL;
+    }
+    return this->types[id];
+}
+
+// Resolves the schema, checking that every type still has the layout it was saved with
+static void SerialReader$schema(SerialReader *this)
+{
+    this->type_count = SerialReader$u32(this);
+    if (!this->ok || this->type_count > (uint64_t)(this->end - this->pos))
+    {
+        this->ok = false;
+        return;
+    }
+
+    // Field type ids can point forward, so they're checked once every type is known
+    Vector field_ids = Vector$new(&type_uint32_t);
+    Vector field_types = Vector$new(&type_type_ptr);
+
+    this->types = Arena$alloc(this->arena, this->type_count * sizeof(const Type *), sizeof(const Type *));
+    for (uint32_t i = 0; i < this->type_count && this->ok; ++i)
+    {
+        const char *name = SerialReader$chars(this, SerialReader$u64(this));
+        uint8_t kind = SerialReader$u8(this);
+        uint32_t size = SerialReader$u32(this);
+        uint32_t alignment = SerialReader$u32(this);
+        uint32_t field_count = SerialReader$u32(this);
+        if (!this->ok)
+        {
+            break;
+        }
+
+        const Type *type = Serial$find_type(name);
+        if (!type || type->kind != (TypeKind)kind || type->size != size || type->alignment != alignment ||
+            (type->kind == TK_COMPLEX ? type->field_count : 0) != field_count)
+        {
+            this->ok = false;
+            break;
+        }
+        this->types[i] = type;
+
+        for (uint32_t f = 0; f < field_count && this->ok; ++f)
+        {
+            const Field *field = type->fields[f];
+            const char *field_name = SerialReader$chars(this, SerialReader$u64(this));
+            uint32_t field_id = SerialReader$u32(this);
+            uint32_t offset = SerialReader$u32(this);
+            uint8_t is_pointer = SerialReader$u8(this);
+            if (!this->ok || strcmp(field_name, field->name) != 0 ||
+                offset != field->struct_offset || (bool)is_pointer != field->is_pointer)
+            {
+                this->ok = false;
+                break;
+            }
+
+            const Type *field_type = field->type;
+            Vector$push(&field_ids, &field_id);
+            Vector$push(&field_types, &field_type);
+        }
+    }
+
+    for (size_t i = 0; i < field_ids.len && this->ok; ++i)
+    {
+        const Type *saved = SerialReader$type(this, ((uint32_t *)field_ids.data)[i]);
+        if (saved && !Serial$same_type(saved, ((const Type **)field_types.data)[i]))
+        {
+            this->ok = false;
+        }
+    }
+
+    Vector$free(&field_types);
+    Vector$free(&field_ids);
+}
+
+static void SerialReader$value(SerialReader *this, const Type *type, void *placement);
+
+static void SerialReader$vector(SerialReader *this, void *placement)
+{
+    Vector vec = { NULL };
+    vec.member_type = SerialReader$type(this, SerialReader$u32(this));
+    uint64_t len = SerialReader$u64(this);
+    if (!this->ok)
+    {
+        return;
+    }
+
+    const Type *member_type = vec.member_type;
+    size_t size = member_type->size;
+    size_t alignment = member_type->alignment ? member_type->alignment : 1;
+    vec.allocator = &this->arena->allocator;
+
+    if (Serial$is_plain(member_type))
+    {
+        size_t offset = (size_t)(this->pos - this->data);
+        SerialReader$take(this, (alignment - offset % alignment) % alignment);
+        if (!this->ok || len > (uint64_t)(this->end - this->pos) / size)
+        {
+            this->ok = false;
+            return;
+        }
+
+        // Point straight into the snapshot when it's aligned well enough
+        const unsigned char *items = SerialReader$take(this, len * size);
+        if (len && (uintptr_t)items % alignment == 0)
+        {
+            vec.data = (void *)items;
+        }
+        else if (len)
+        {
+            vec.data = Arena$alloc(this->arena, (size_t)len * size, alignment);
+            memcpy(vec.data, items, (size_t)len * size);
+        }
+    }
+    else
+    {
+        // Every element takes at least a byte, which bounds len
+        if (len > (uint64_t)(this->end - this->pos))
+        {
+            this->ok = false;
+            return;
+        }
+
+        if (len)
+        {
+            vec.data = Arena$alloc(this->arena, (size_t)len * size, alignment);
+            memset(vec.data, 0, (size_t)len * size);
+        }
+        for (size_t i = 0; i < len && this->ok; ++i)
+        {
+            SerialReader$value(this, member_type, (char *)vec.data + i * size);
+        }
+    }
+
+    vec.len = (size_t)len;
+    vec.cap = (size_t)len;
+    memcpy(placement, &vec, sizeof(vec));
+}
+
+static void SerialReader$value(SerialReader *this, const Type *type, void *placement)
+{
+    if (Serial$is_plain(type))
+    {
+        const unsigned char *data = SerialReader$take(this, type->size);
+        if (data)
+        {
+            memcpy(placement, data, type->size);
+        }
+        return;
+    }
+    if (this->depth >= SERIAL_MAX_DEPTH)
+    {
+        this->ok = false;
+        return;
+    }
+
+    this->depth++;
+    if (type == &type_cstr)
+    {
+        uint64_t len = SerialReader$u64(this);
+        const char *cstr = len == SERIAL_NULL_CSTR ? NULL : SerialReader$chars(this, len);
+        memcpy(placement, &cstr, sizeof(cstr));
+    }
+    else if (type == &type_string)
+    {
+        // A literal String, which never frees or writes to its characters
+        uint64_t len = SerialReader$u64(this);
+        String str = { (char *)SerialReader$chars(this, len), (size_t)len, 0 };
+        if (!this->ok)
+        {
+            str = String$EMPTY;
+        }
+        memcpy(placement, &str, sizeof(str));
+    }
+    else if (type == &type_vector)
+    {
+        SerialReader$vector(this, placement);
+    }
+    else if (type->kind == TK_COMPLEX && type->field_count)
+    {
+        memset(placement, 0, type->size);
+        for (unsigned i = 0; i < type->field_count && this->ok; ++i)
+        {
+            const Field *field = type->fields[i];
+            void *field_value = (char *)placement + field->struct_offset;
+            if (field->is_pointer)
+            {
+                if (!SerialReader$u8(this))
+                {
+                    continue;
+                }
+
+                void *target = Arena$alloc(this->arena, field->type->size, field->type->alignment);
+                memcpy(field_value, &target, sizeof(target));
+                field_value = target;
+            }
+            SerialReader$value(this, field->type, field_value);
+        }
+    }
+    else
+    {
+        this->ok = false;
+    }
+    this->depth--;
+}
+
+bool Serial$load(const void *data, size_t size, Arena *arena, const Type *type, void *placement)
+{
+    assert(arena && "Serial$load needs an arena to allocate from");
+
+    SerialReader reader = { data, data, (const unsigned char *)data + size, arena };
+    reader.ok = true;
+
+    if (SerialReader$u32(&reader) != SERIAL_MAGIC || SerialReader$u32(&reader) != SERIAL_VERSION)
+    {
+        return false;
+    }
+
+    SerialReader$schema(&reader);
+    if (!reader.ok)
+    {
+        return false;
+    }
+
+    const Type *root = SerialReader$type(&reader, SerialReader$u32(&reader));
+    if (!reader.ok || !Serial$same_type(root, type))
+    {
+        return false;
+    }
+
+    SerialReader$value(&reader, root, placement);
+    return reader.ok;
+}
+
+// Size of the file, which may be past what a long can hold
+static bool Serial$file_size(FILE *stream, uint64_t *size)
+{
+#ifdef _MSC_VER
+    bool ok = _fseeki64(stream, 0, SEEK_END) == 0;
+    int64_t end = _ftelli64(stream);
+    ok = ok && _fseeki64(stream, 0, SEEK_SET) == 0;
+#else
+    bool ok = fseeko(stream, 0, SEEK_END) == 0;
+    int64_t end = (int64_t)ftello(stream);
+    ok = ok && fseeko(stream, 0, SEEK_SET) == 0;
+#endif
+    *size = (uint64_t)end;
+    return ok && end >= 0;
+}
+
+bool Serial$load_file(const char *path, Arena *arena, const Type *type, void *placement)
+{
+    FILE *stream = fopen(path, "rb");
+    if (!stream)
+    {
+        return false;
+    }
+
+    // One read straight into arena memory, which the loaded value then borrows from
+    uint64_t size = 0;
+    bool ok = Serial$file_size(stream, &size) && size <= (size_t)-1;
+    unsigned char *data = NULL;
+    if (ok)
+    {
+        data = Arena$alloc(arena, (size_t)size, 64);
+        ok = fread(data, 1, (size_t)size, stream) == size;
+    }
+
+    fclose(stream);
+    return ok && Serial$load(data, (size_t)size, arena, type, placement);
+}
@@ -0,0 +1,49 @@
+////////////////////////////////////////////
+// File    : serialize.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+struct Type;
+struct Arena;
+
+// Binary snapshots of reflected values. A snapshot starts with a schema
+// naming every type it uses along with its field layout, followed by the
+// value itself. Primitives, cstrs, String, Vector, and complex types whose
+// fields are all of those can be saved. Pointer fields are saved as the
+// value they point at, or as missing when they're NULL.
+//
+// Plain data (primitives, and TT_TRIVIAL_COPY types whose fields are all
+// plain data) is written as raw bytes. Vectors of plain data are written
+// as one aligned block, and loading points them straight into the
+// snapshot instead of copying.
+
+// Snapshots can only be loaded once their types are registered. The
+// primitives, cstr, String and Vector are built in. Registering a complex
+// type also registers the types of its fields. The first type registered
+// under a name is the one that's kept.
+void Serial$register(const struct Type *type);
+// The registered type with that name, or NULL
+const struct Type *Serial$find_type(const char *name);
+
+// Return false if the value holds something that can't be saved, or if
+// writing fails
+bool Serial$save(FILE *stream, const struct Type *type, const void *value);
+bool Serial$save_file(const char *path, const struct Type *type, const void *value);
+
+// Loads a value of type into placement. Strings, cstrs and plain data
+// Vectors borrow from data, and everything else is allocated from arena,
+// so both must outlive the value. Loaded values never need to be freed,
+// resetting the arena releases them. Returns false if the snapshot is
+// malformed, or a type in it isn't registered or has a different layout.
+bool Serial$load(const void *data, size_t size, struct Arena *arena,
+                 const struct Type *type, void *placement);
+// Reads the whole file into the arena, then loads from that
+bool Serial$load_file(const char *path, struct Arena *arena,
+                      const struct Type *type, void *placement);
@@ -0,0 +1,240 @@
+////////////////////////////////////////////
+// File    : soa.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "soa.h"
+#include "rtti.h"
+#include "allocator.h"
+#include <string.h>
+#include <assert.h>
+
+#define SOA_NO_FIELD ((unsigned)-1)
+
+static size_t SoaVector$field_size(const Field *field);
+static void *SoaVector$cell(const SoaVector *this, unsigned field_index, size_t index);
+static void SoaVector$destroy_cell(const SoaVector *this, unsigned field_index, size_t index);
+static void SoaVector$grow(SoaVector *this, size_t minimum);
+
+SoaVector SoaVector$new(const Type *record_type)
+{
+    assert(record_type->kind == TK_COMPLEX && record_type->field_count &&
+           "SoaVector records must be complex types with fields");
+
+    SoaVector soa = { NULL };
+    soa.record_type = record_type;
+    soa.allocator = Allocator$current();
+
+    size_t columns_size = record_type->field_count * sizeof(void *);
+    soa.columns = Allocator$alloc(soa.allocator, columns_size, sizeof(void *));
+    memset(soa.columns, 0, columns_size);
+
+    return soa;
+}
+
+void SoaVector$free(SoaVector *this)
+{
+    SoaVector$clear(this);
+
+    const Type *type = this->record_type;
+    if (this->columns)
+    {
+        for (unsigned i = 0; i < type->field_count; ++i)
+        {
+            Allocator$free(this->allocator, this->columns[i],
+                           this->cap * SoaVector$field_size(type->fields[i]));
+        }
+        Allocator$free(this->allocator, this->columns, type->field_count * sizeof(void *));
+    }
+    this->columns = NULL;
+    this->cap = 0;
+}
+
+size_t SoaVector$len(const SoaVector *this)
+{
+    return this->len;
+}
+
+void SoaVector$reserve(SoaVector *this, size_t cap)
+{
+    if (this->cap < cap)
+    {
+        SoaVector$grow(this, cap);
+    }
+}
+
+void SoaVector$clear(SoaVector *this)
+{
+    const Type *type = this->record_type;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        // Whole columns of plain data need no work
+        const Field *field = type->fields[f];
+        if (field->is_pointer || Type$has_traits(field->type, TT_TRIVIAL_DESTROY))
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < this->len; ++i)
+        {
+            SoaVector$destroy_cell(this, f, i);
+        }
+    }
+    this->len = 0;
+}
+
+void SoaVector$push(SoaVector *this, const void *record)
+{
+    SoaVector$reserve(this, this->len + 1);
+
+    const Type *type = this->record_type;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        const Field *field = type->fields[f];
+        memcpy(SoaVector$cell(this, f, this->len),
+               (const char *)record + field->struct_offset, SoaVector$field_size(field));
+    }
+    this->len++;
+}
+
+void SoaVector$get(const SoaVector *this, size_t index, void *record)
+{
+    assert(index < this->len && "SoaVector$get index out of range");
+
+    const Type *type = this->record_type;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        const Field *field = type->fields[f];
+        char *dest = (char *)record + field->struct_offset;
+        if (field->is_pointer)
+        {
+            memcpy(dest, SoaVector$cell(this, f, index), sizeof(void *));
+        }
+        else
+        {
+            Type$copy_value(field->type, dest, SoaVector$cell(this, f, index));
+        }
+    }
+}
+
+void SoaVector$set(SoaVector *this, size_t index, const void *record)
+{
+    assert(index < this->len && "SoaVector$set index out of range");
+
+    const Type *type = this->record_type;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        const Field *field = type->fields[f];
+        SoaVector$destroy_cell(this, f, index);
+        memcpy(SoaVector$cell(this, f, index),
+               (const char *)record + field->struct_offset, SoaVector$field_size(field));
+    }
+}
+
+void SoaVector$pop(SoaVector *this, void *record)
+{
+    assert(this->len && "SoaVector$pop on an empty SoaVector");
+
+    const Type *type = this->record_type;
+    --this->len;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        const Field *field = type->fields[f];
+        memcpy((char *)record + field->struct_offset,
+               SoaVector$cell(this, f, this->len), SoaVector$field_size(field));
+    }
+}
+
+void SoaVector$swap_remove(SoaVector *this, size_t index)
+{
+    assert(index < this->len && "SoaVector$swap_remove index out of range");
+
+    const Type *type = this->record_type;
+    size_t last = --this->len;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        SoaVector$destroy_cell(this, f, index);
+        if (index != last)
+        {
+            memcpy(SoaVector$cell(this, f, index), SoaVector$cell(this, f, last),
+                   SoaVector$field_size(type->fields[f]));
+        }
+    }
+}
+
+void *SoaVector$column(const SoaVector *this, unsigned field_index)
+{
+    assert(field_index < this->record_type->field_count && "SoaVector$column index out of range");
+    return this->columns[field_index];
+}
+
+void *SoaVector$column_named(const SoaVector *this, const char *field_name)
+{
+    unsigned field_index = SoaVector$field_index(this, field_name);
+    if (field_index == SOA_NO_FIELD)
+    {
+        return NULL;
+    }
+    return this->columns[field_index];
+}
+
+unsigned SoaVector$field_index(const SoaVector *this, const char *field_name)
+{
+    const Type *type = this->record_type;
+    const Field *field = Type$find_field(type, field_name);
+    if (!field)
+    {
+        return SOA_NO_FIELD;
+    }
+
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        if (type->fields[f] == field)
+        {
+            return f;
+        }
+    }
+    return SOA_NO_FIELD;
+}
+
+static size_t SoaVector$field_size(const Field *field)
+{
+    return field->is_pointer ? sizeof(void *) : field->type->size;
+}
+
+static void *SoaVector$cell(const SoaVector *this, unsigned field_index, size_t index)
+{
+    return (char *)this->columns[field_index] + index * SoaVector$field_size(this->record_type->fields[field_index]);
+}
+
+static void SoaVector$destroy_cell(const SoaVector *this, unsigned field_index, size_t index)
+{
+    const Field *field = this->record_type->fields[field_index];
+    if (!field->is_pointer)
+    {
+        Type$destroy_value(field->type, SoaVector$cell(this, field_index, index));
+    }
+}
+
+static void SoaVector$grow(SoaVector *this, size_t minimum)
+{
+    size_t new_cap = this->cap * 2;
+    if (new_cap < minimum)
+    {
+        new_cap = minimum;
+    }
+
+    const Type *type = this->record_type;
+    for (unsigned f = 0; f < type->field_count; ++f)
+    {
+        const Field *field = type->fields[f];
+        size_t size = SoaVector$field_size(field);
+        void *column = this->columns[f];
+
+        size_t alignment = field->is_pointer ? sizeof(void *) : field->type->alignment;
+        this->columns[f] = Allocator$realloc(this->allocator, column, this->cap * size,
+                                             new_cap * size, alignment);
+    }
+    this->cap = new_cap;
+}
@@ -0,0 +1,62 @@
+////////////////////////////////////////////
+// File    : soa.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdlib.h>
+
+typedef struct SoaVector SoaVector;
+struct Type;
+struct Field;
+struct Allocator;
+
+// Stores records of a complex type as structure-of-arrays: every Field
+// of the record type gets its own contiguous column, so a loop over one
+// field streams only that field's bytes. Pointer fields are stored as
+// borrowed pointers. Like Vector, SoaVectors keep their columns in
+// Allocator$current() from when they were made, which is the active
+// arena if there is one.
+SoaVector SoaVector$new(const struct Type *record_type);
+void      SoaVector$free(SoaVector *this);
+
+size_t SoaVector$len(const SoaVector *this);
+void   SoaVector$reserve(SoaVector *this, size_t cap);
+// Destroys every record but keeps the columns allocated
+void   SoaVector$clear(SoaVector *this);
+
+// Scatters the record's fields into the columns. Takes ownership of the
+// fields, like Vector$push, so don't free the record afterwards.
+void SoaVector$push(SoaVector *this, const void *record);
+// Gathers copies of the fields at index into record. Bytes of the record
+// that aren't covered by a Field are left alone.
+void SoaVector$get(const SoaVector *this, size_t index, void *record);
+// Destroys the fields at index and replaces them with the fields of record
+void SoaVector$set(SoaVector *this, size_t index, const void *record);
+// Moves the last record into record, which the caller then owns
+void SoaVector$pop(SoaVector *this, void *record);
+// Destroys the record at index and moves the last record into its place
+void SoaVector$swap_remove(SoaVector *this, size_t index);
+
+// Columns are indexed like the record type's fields array. Column storage
+// moves when the SoaVector grows, so fetch it again after pushing.
+void  *SoaVector$column(const SoaVector *this, unsigned field_index);
+// Column for the named field, or NULL if the record type has no such field
+void  *SoaVector$column_named(const SoaVector *this, const char *field_name);
+// Index of the field, or (unsigned)-1 if the record type has no such field
+unsigned SoaVector$field_index(const SoaVector *this, const char *field_name);
+
+// Typed access for tight loops:
+//   float *health = SOA_COLUMN(&entities, float, "health");
+#define SOA_COLUMN(soa, T, field_name) ((T *)SoaVector$column_named((soa), (field_name)))
+
+struct SoaVector
+{
+    const struct Type *record_type;
+    void **columns; // One array per field, in field order
+    size_t len;
+    size_t cap;
+    struct Allocator *allocator; // Owner of the columns, NULL for the heap
+};
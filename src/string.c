@@ -7,37 +7,96 @@
 #include "string.h"
 #include "rtti.h"
 #include "helpers.h"
+#include "allocator.h"
+#include "string_simd.h"
+#include "hash.h"
+#include "format.h"
+#include "writer.h"
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
 
 static size_t String$extra_cap(const String *this);
+static size_t String$capacity(const String *this);
+static bool String$is_inline(const String *this);
+static char *String$chars(String *this);
+static void String$set_len(String *this, size_t len);
 static void String$grow(String *this, size_t minimum);
+static void String$grow_in(String *this, Allocator *allocator, size_t new_size);
+static char *String$extend(String *this, size_t count);
+
+// Short strings are stored inside the String itself. The characters
+// and their NUL fill the struct, and the last byte holds
+// STRING_INLINE_FLAG | len. On the little-endian targets we build for
+// that byte is the top of cap, which heap strings never set.
+#define STRING_INLINE_FLAG 0x80
+#define STRING_TAG(this) (((unsigned char *)(this))[sizeof(String) - 1])
+
+// Compares up to this length are done inline rather than
+// going through the SIMD kernels
+#define STRING_SHORT_LEN 16
+
+// The second-highest bit of cap marks a buffer from an Allocator other
+// than the heap. The allocator is stored just in front of the characters.
+#define STRING_ALLOCATOR_BIT ((size_t)1 << (sizeof(size_t) * 8 - 2))
+#define STRING_HEADER sizeof(Allocator *)
 
 struct String String$EMPTY = { "", 0, 0 };
 
 String String$new()
 {
-    return String$EMPTY;
+    // Inside an arena scope the string has to take a buffer now, it's
+    // the only place to remember where it was constructed
+    Allocator *allocator = Allocator$current();
+    if (allocator == &Allocator$heap)
+    {
+        return String$EMPTY;
+    }
+    return String$new_in(allocator, 0);
 }
 
 String String$copy(const String *this)
 {
-    String copy = String$EMPTY;
+    String copy = String$new_in(Allocator$current(), String$len(this));
     String$append(&copy, *this);
     return copy;
 }
 
 void String$free(String *this)
 {
-    if (this->cap)
+    // Inline strings own nothing
+    if (!String$is_inline(this) && this->cap)
     {
-        free(this->data);
+        if (this->cap & STRING_ALLOCATOR_BIT)
+        {
+            Allocator$free(String$allocator(this), this->data - STRING_HEADER,
+                           STRING_HEADER + String$capacity(this));
+        }
+        else
+        {
+            free(this->data);
+        }
     }
 
     *this = String$EMPTY;
 }
 
+String String$new_in(Allocator *allocator, size_t cap)
+{
+    String result = String$EMPTY;
+    if (!allocator || allocator == &Allocator$heap)
+    {
+        // Inline strings grow on the heap, so nothing needs recording
+        String$reserve(&result, cap);
+    }
+    else
+    {
+        // Always take a buffer, it's the only place to remember the allocator
+        String$grow_in(&result, allocator, cap + 1);
+    }
+    return result;
+}
+
 String String$from_cstr(const char *str)
 {
     String ref = String$from_literal(str);
@@ -55,29 +114,120 @@ String String$from_literal(const char *lit)
 
 const char *String$cstr(const String *this)
 {
+    if (String$is_inline(this))
+    {
+        return (const char *)this;
+    }
     return this->data;
 }
 
 size_t String$len(const String *this)
 {
+    if (String$is_inline(this))
+    {
+        return STRING_TAG(this) & ~STRING_INLINE_FLAG;
+    }
     return this->len;
 }
 
 bool String$equal(String lhs, String rhs)
 {
-    return String$compare(lhs, rhs) == 0;
+    size_t len = String$len(&lhs);
+    if (len != String$len(&rhs))
+    {
+        return false;
+    }
+    // Short strings aren't worth the dispatch
+    const char *l = String$cstr(&lhs);
+    const char *r = String$cstr(&rhs);
+    if (len <= STRING_SHORT_LEN)
+    {
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (l[i] != r[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return StringKernels$get()->equal(l, r, len);
 }
 
 int String$compare(String lhs, String rhs)
 {
-    return strcmp(lhs.data, rhs.data);
+    size_t lhs_len = String$len(&lhs);
+    size_t rhs_len = String$len(&rhs);
+    size_t common = lhs_len < rhs_len ? lhs_len : rhs_len;
+
+    const char *l = String$cstr(&lhs);
+    const char *r = String$cstr(&rhs);
+    if (common <= STRING_SHORT_LEN)
+    {
+        for (size_t i = 0; i < common; ++i)
+        {
+            if (l[i] != r[i])
+            {
+                return (unsigned char)l[i] < (unsigned char)r[i] ? -1 : 1;
+            }
+        }
+    }
+    else
+    {
+        int result = StringKernels$get()->compare(l, r, common);
+        if (result)
+        {
+            return result;
+        }
+    }
+
+    // Equal up to the shorter one, so the shorter one comes first
+    return (lhs_len > rhs_len) - (lhs_len < rhs_len);
+}
+
+int String$compare_nocase(String lhs, String rhs)
+{
+    size_t lhs_len = String$len(&lhs);
+    size_t rhs_len = String$len(&rhs);
+    size_t common = lhs_len < rhs_len ? lhs_len : rhs_len;
+
+    int result = StringKernels$get()->compare_nocase(String$cstr(&lhs), String$cstr(&rhs), common);
+    if (result)
+    {
+        return result;
+    }
+
+    return (lhs_len > rhs_len) - (lhs_len < rhs_len);
+}
+
+size_t String$find(String haystack, String needle)
+{
+    size_t len = String$len(&haystack);
+    size_t found = StringKernels$get()->find(String$cstr(&haystack), len,
+                                             String$cstr(&needle), String$len(&needle));
+    return found == len && String$len(&needle) ? STRING_NPOS : found;
+}
+
+size_t String$find_char(String haystack, char c)
+{
+    size_t len = String$len(&haystack);
+    size_t found = StringKernels$get()->find_byte(String$cstr(&haystack), len, c);
+    return found == len ? STRING_NPOS : found;
+}
+
+size_t String$find_any(String haystack, String charset)
+{
+    size_t len = String$len(&haystack);
+    size_t found = StringKernels$get()->find_any(String$cstr(&haystack), len,
+                                                 String$cstr(&charset), String$len(&charset));
+    return found == len ? STRING_NPOS : found;
 }
 
 void String$reserve(String *this, size_t minimum)
 {
     // If our capacity isn't enough for minimum plus
     // a NUL terminator, grow it
-    if (this->cap <= minimum + 1)
+    if (String$capacity(this) < minimum + 1)
     {
         String$grow(this, minimum);
     }
@@ -85,64 +235,240 @@ void String$reserve(String *this, size_t minimum)
 
 void String$append(String *this, String rhs)
 {
+    size_t len = String$len(this);
+    size_t rhs_len = String$len(&rhs);
     // Ensure the string can fit [this.., rhs.., '\0']
-    String$reserve(this, this->len + rhs.len);
+    String$reserve(this, len + rhs_len);
     // Copy rhs into our data
-    memcpy(this->data + this->len, rhs.data, rhs.len);
-    // Increment the length
-    this->len += rhs.len;
+    char *data = String$chars(this);
+    memcpy(data + len, String$cstr(&rhs), rhs_len);
     // Apply the NUL terminator
-    this->data[this->len] = 0;
+    data[len + rhs_len] = 0;
+    // Increment the length
+    String$set_len(this, len + rhs_len);
 }
 
 void String$prepend(String *this, String rhs)
 {
+    size_t len = String$len(this);
+    size_t rhs_len = String$len(&rhs);
     // Ensure the string can fit [rhs.., this.., '\0']
-    String$reserve(this, this->len + rhs.len);
+    String$reserve(this, len + rhs_len);
     // Shift the string over
-    memmove(this->data + rhs.len, this->data, this->len);
+    char *data = String$chars(this);
+    memmove(data + rhs_len, data, len);
     // Copy the new prefix in
-    memcpy(this->data, rhs.data, rhs.len);
-    // Increment the length
-    this->len += rhs.len;
+    memcpy(data, String$cstr(&rhs), rhs_len);
     // Apply the NUL terminator
-    this->data[this->len] = 0;
+    data[len + rhs_len] = 0;
+    // Increment the length
+    String$set_len(this, len + rhs_len);
 }
 
 void String$push(String *this, char c)
 {
+    size_t len = String$len(this);
     // Ensure there is room to push a character
-    String$reserve(this, this->len + 1);
-    // Push a character
-    this->data[this->len++] = c;
-    // Push the NUL terminator
-    this->data[this->len] = 0;
+    String$reserve(this, len + 1);
+    // Push a character and the NUL terminator
+    char *data = String$chars(this);
+    data[len] = c;
+    data[len + 1] = 0;
+    String$set_len(this, len + 1);
 }
 
 void String$pop(String *this)
 {
+    size_t len = String$len(this);
+
     // There is no popping to do if the string is empty
-    if (!this->len)
+    if (!len)
     {
         return;
     }
 
     // Make sure we own the string
-    if (!this->cap)
+    String$reserve(this, len);
+
+    // Pop a character
+    String$chars(this)[len - 1] = 0;
+    String$set_len(this, len - 1);
+}
+
+void String$append_int(String *this, int64_t value)
+{
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    Format$int(String$extend(this, (value < 0) + Format$digit_count(magnitude)), value);
+}
+
+void String$append_uint(String *this, uint64_t value)
+{
+    Format$uint(String$extend(this, Format$digit_count(value)), value);
+}
+
+void String$append_hex(String *this, uint64_t value)
+{
+    Format$hex(String$extend(this, Format$hex_digit_count(value)), value);
+}
+
+void String$append_float(String *this, float value)
+{
+    // The length isn't known until the digits are generated
+    char digits[FORMAT_NUMBER_MAX];
+    size_t len = Format$float(digits, value);
+    memcpy(String$extend(this, len), digits, len);
+}
+
+void String$append_double(String *this, double value)
+{
+    char digits[FORMAT_NUMBER_MAX];
+    size_t len = Format$double(digits, value);
+    memcpy(String$extend(this, len), digits, len);
+}
+
+StringFormat StringFormat$compile(const char *text)
+{
+    StringFormat format = { text };
+    const char *pos = text;
+    while (*pos)
     {
-        String$reserve(this, this->len);
+        // The checks below only assert, release builds compile what they
+        // can of a bad format rather than writing past the segments
+        assert(format.segment_count < STRING_FORMAT_MAX_SEGMENTS && "Too many pieces in the format");
+        if (format.segment_count == STRING_FORMAT_MAX_SEGMENTS)
+        {
+            break;
+        }
+        StringFormatSegment *segment = &format.segments[format.segment_count++];
+
+        if ((pos[0] == '{' && pos[1] == '{') || (pos[0] == '}' && pos[1] == '}'))
+        {
+            // Escaped brace
+            segment->text = pos;
+            segment->len = 1;
+            pos += 2;
+        }
+        else if (pos[0] == '{')
+        {
+            segment->hex = pos[1] == 'x';
+            pos += segment->hex ? 2 : 1;
+            assert(*pos == '}' && "Format placeholders must be {} or {x}");
+            if (*pos == '}')
+            {
+                pos++;
+            }
+            format.arg_count++;
+        }
+        else
+        {
+            // Run of plain text up to the next brace. A lone } is kept as text.
+            const char *start = pos;
+            assert(*pos != '}' && "Unmatched } in format");
+            if (*pos == '}')
+            {
+                pos++;
+            }
+            while (*pos && *pos != '{' && *pos != '}')
+            {
+                pos++;
+            }
+            segment->text = start;
+            segment->len = (uint32_t)(pos - start);
+        }
     }
+    return format;
+}
 
-    // Pop a character
-    this->data[--this->len] = 0;
+// Finds the characters for one argument, formatting
+// numbers and other values into scratch
+static size_t String$format_arg(const Any *arg, bool hex, char *scratch, size_t scratch_size,
+                                const char **chars)
+{
+    const Type *type = arg->type;
+    *chars = scratch;
+
+    if (type == &type_string || type == &type_string_ptr)
+    {
+        const String *str = (const String *)Any$data(arg);
+        *chars = String$cstr(str);
+        return String$len(str);
+    }
+    if (type == &type_cstr)
+    {
+        *chars = arg->value.cstr;
+        return strlen(arg->value.cstr);
+    }
+    if (hex && type && type->kind == TK_PRIMITIVE && type != &type_float && type != &type_double)
+    {
+        uint64_t value = 0;
+        memcpy(&value, &arg->value, type->size);
+        return Format$hex(scratch, value);
+    }
+
+    if (type == &type_int8_t) { return Format$int(scratch, arg->value.i8); }
+    if (type == &type_uint8_t) { return Format$uint(scratch, arg->value.u8); }
+    if (type == &type_int16_t) { return Format$int(scratch, arg->value.i16); }
+    if (type == &type_uint16_t) { return Format$uint(scratch, arg->value.u16); }
+    if (type == &type_int32_t) { return Format$int(scratch, arg->value.i32); }
+    if (type == &type_uint32_t) { return Format$uint(scratch, arg->value.u32); }
+    if (type == &type_int64_t) { return Format$int(scratch, arg->value.i64); }
+    if (type == &type_uint64_t) { return Format$uint(scratch, arg->value.u64); }
+    if (type == &type_size_t) { return Format$uint(scratch, sizeof(size_t) == 8 ? arg->value.u64 : arg->value.u32); }
+    if (type == &type_float) { return Format$float(scratch, arg->value.f32); }
+    if (type == &type_double) { return Format$double(scratch, arg->value.f64); }
+
+    // Anything else is written like Any$print would, cut off if it's long
+    Writer writer = Writer$to_buffer(scratch, scratch_size);
+    Any$write(*arg, &writer);
+    return writer.used;
+}
+
+void String$format(String *this, const StringFormat *format, unsigned arg_count, const Any *args)
+{
+    assert(arg_count >= format->arg_count && "Not enough arguments for the format");
+
+    // Measure everything first so the string only grows once
+    char scratch[STRING_FORMAT_MAX_SEGMENTS][64];
+    const char *chars[STRING_FORMAT_MAX_SEGMENTS];
+    size_t lens[STRING_FORMAT_MAX_SEGMENTS];
+    size_t total = 0;
+    unsigned arg = 0;
+    for (unsigned i = 0; i < format->segment_count; ++i)
+    {
+        const StringFormatSegment *segment = &format->segments[i];
+        if (segment->text)
+        {
+            chars[i] = segment->text;
+            lens[i] = segment->len;
+        }
+        else if (arg < arg_count)
+        {
+            lens[i] = String$format_arg(&args[arg++], segment->hex, scratch[i], sizeof(scratch[i]), &chars[i]);
+        }
+        else
+        {
+            // Release builds leave placeholders without an argument empty
+            chars[i] = "";
+            lens[i] = 0;
+        }
+        total += lens[i];
+    }
+
+    char *dest = String$extend(this, total);
+    for (unsigned i = 0; i < format->segment_count; ++i)
+    {
+        memcpy(dest, chars[i], lens[i]);
+        dest += lens[i];
+    }
 }
 
 static size_t String$extra_cap(const String *this)
 {
-    if (this->cap)
+    size_t cap = String$capacity(this);
+    if (cap)
     {
         // Subtract 1 to maintain the cstr property
-        return this->cap - this->len - 1;
+        return cap - String$len(this) - 1;
     }
     else
     {
@@ -150,38 +476,122 @@ static size_t String$extra_cap(const String *this)
     }
 }
 
+static bool String$is_inline(const String *this)
+{
+    return (STRING_TAG(this) & STRING_INLINE_FLAG) != 0;
+}
+
+static char *String$chars(String *this)
+{
+    if (String$is_inline(this))
+    {
+        return (char *)this;
+    }
+    return this->data;
+}
+
+static void String$set_len(String *this, size_t len)
+{
+    if (String$is_inline(this))
+    {
+        STRING_TAG(this) = (unsigned char)(STRING_INLINE_FLAG | len);
+    }
+    else
+    {
+        this->len = len;
+    }
+}
+
+// Makes room for count more characters at the end and
+// returns where they go. The caller has to fill all of them.
+static char *String$extend(String *this, size_t count)
+{
+    size_t len = String$len(this);
+    String$reserve(this, len + count);
+    char *data = String$chars(this);
+    data[len + count] = 0;
+    String$set_len(this, len + count);
+    return data + len;
+}
+
+static size_t String$capacity(const String *this)
+{
+    if (String$is_inline(this))
+    {
+        return STRING_INLINE_CAP + 1;
+    }
+    return this->cap & ~STRING_ALLOCATOR_BIT;
+}
+
+Allocator *String$allocator(const String *this)
+{
+    if (String$is_inline(this) || !this->cap)
+    {
+        return NULL;
+    }
+    if (this->cap & STRING_ALLOCATOR_BIT)
+    {
+        return ((Allocator **)this->data)[-1];
+    }
+    return &Allocator$heap;
+}
+
 static void String$grow(String *this, size_t minimum)
 {
     size_t new_size;
+    size_t len = String$len(this);
+    size_t cap = String$capacity(this);
+    bool is_inline = String$is_inline(this);
 
-    // We shouldn't do anything if they're asking for nothing
-    if (minimum == 0)
+    // We shouldn't do anything if they're asking for nothing,
+    // unless we don't own the string yet
+    if (minimum == 0 && cap)
     {
         return;
     }
 
     // Ensure this new minimum isn't less than the string
     // we're already storing
-    if (minimum < this->len)
+    if (minimum < len)
+    {
+        minimum = len;
+    }
+
+    // A literal that fits moves inline and skips the allocation
+    if (!cap && minimum <= STRING_INLINE_CAP)
     {
-        minimum = this->len;
+        const char *lit = this->data;
+        memmove((char *)this, lit, len);
+        ((char *)this)[len] = 0;
+        STRING_TAG(this) = (unsigned char)(STRING_INLINE_FLAG | len);
+        return;
     }
 
     // Try to double the size, but if that isn't
     // big enough just set it to the minumum required
-    if (this->cap * 2 >= minimum + 1)
+    if (cap * 2 >= minimum + 1)
     {
-        new_size = this->cap * 2;
+        new_size = cap * 2;
     }
     else
     {
         new_size = minimum + 1;
     }
 
+    // Strings stay with the allocator they started in. Strings that
+    // don't own a buffer yet may be literals or globals that outlive
+    // any scope, so they go to the heap rather than the current one.
+    Allocator *allocator = (cap && !is_inline) ? String$allocator(this) : &Allocator$heap;
+    if (allocator != &Allocator$heap)
+    {
+        String$grow_in(this, allocator, new_size);
+        return;
+    }
+
     // If the string has already been allocated by us,
     // we can just use realloc. Otherwise, we have to malloc
     // new space and copy the string we didn't own in.
-    if (this->cap)
+    if (cap && !is_inline)
     {
         char *temp = realloc(this->data, new_size);
         assert(temp && "Uh oh, memory allocation failed");
@@ -191,13 +601,41 @@ static void String$grow(String *this, size_t minimum)
     {
         char *temp = malloc(new_size);
         assert(temp && "Uh oh, memory allocation failed");
-        memcpy(temp, this->data, this->len);
-        temp[this->len] = 0;
+        memcpy(temp, String$cstr(this), len);
+        temp[len] = 0;
         this->data = temp;
     }
+    this->len = len;
     this->cap = new_size;
 }
 
+// Moves the string into a new_size buffer from allocator, with the
+// allocator stored in front. Buffers it owns already must come from it.
+static void String$grow_in(String *this, Allocator *allocator, size_t new_size)
+{
+    size_t len = String$len(this);
+    size_t cap = String$capacity(this);
+    bool owned = cap && !String$is_inline(this);
+
+    char *block;
+    if (owned)
+    {
+        block = Allocator$realloc(allocator, this->data - STRING_HEADER, STRING_HEADER + cap,
+                                  STRING_HEADER + new_size, sizeof(Allocator *));
+    }
+    else
+    {
+        block = Allocator$alloc(allocator, STRING_HEADER + new_size, sizeof(Allocator *));
+        memcpy(block + STRING_HEADER, String$cstr(this), len);
+        block[STRING_HEADER + len] = 0;
+    }
+
+    *(Allocator **)block = allocator;
+    this->data = block + STRING_HEADER;
+    this->len = len;
+    this->cap = new_size | STRING_ALLOCATOR_BIT;
+}
+
 ///////////////////////////////////////////////
 // String RTTI
 
@@ -210,7 +648,8 @@ static Any rtti_constructor(void *obj, unsigned arg_count, Any *arguments)
     {
         case 0: // Default constructor
         {
-            result = Any$from_complex(&type_string, &String$EMPTY);
+            String temp = String$new();
+            result = Any$from_complex(&type_string, &temp);
             break;
         }
         case 1: // 1-arg constructor
@@ -224,11 +663,17 @@ static Any rtti_constructor(void *obj, unsigned arg_count, Any *arguments)
             }
             else if (arguments[0].type == &type_string) // Copy constructor
             {
-                String temp, copied;
-                Any$unpack(arguments[0], &temp);
-                Any$soft_release(&arguments[0]);
-
-                copied = String$copy(&temp);
+                String temp;
+                if (arguments[0].storage == AS_REF)
+                {
+                    temp = String$copy((const String *)Any$data(&arguments[0]));
+                }
+                else
+                {
+                    // We own the argument, so take its value instead of copying
+                    Any$unpack(arguments[0], &temp);
+                    Any$soft_release(&arguments[0]);
+                }
                 result = Any$from_complex(&type_string, &temp);
                 break;
             }
@@ -315,6 +760,26 @@ static Any rtti_len(void *obj, unsigned arg_count, Any *arguments)
     return Any$from_size_t(String$len((const String *)obj));
 }
 
+static void rtti_len_batch(void *objects, size_t stride, size_t count,
+                           unsigned arg_count, Any *arguments, Any *results)
+{
+    (arg_count, arguments); // unreferenced parameters
+    if (!results)
+    {
+        return; // Nothing to do, len has no side effects
+    }
+
+    // Every result is the same Any apart from the value
+    Any result = Any$from_size_t(0);
+    const char *obj = (const char *)objects;
+    for (size_t i = 0; i < count; ++i, obj += stride)
+    {
+        size_t len = String$len((const String *)obj);
+        memcpy(&result.value, &len, sizeof(len));
+        results[i] = result;
+    }
+}
+
 static Member len_member =
 {
     "len",
@@ -323,6 +788,7 @@ static Member len_member =
     &type_size_t, // Return type
     false, // static
     false, // overloaded
+    rtti_len_batch,
 };
 
 static Any rtti_append(void *obj, unsigned arg_count, Any *arguments)
@@ -330,9 +796,9 @@ static Any rtti_append(void *obj, unsigned arg_count, Any *arguments)
     assert(arg_count == 1);
 
     String *this = (String *)obj;
-    if (arguments[0].type == &type_string || arguments[1].type == &type_string_ptr)
+    if (arguments[0].type == &type_string || arguments[0].type == &type_string_ptr)
     {
-        String *rhs = (String *)arguments[0].value.ptr;
+        String *rhs = (String *)Any$data(&arguments[0]);
         String$append(this, *rhs);
     }
     else if (arguments[0].type == &type_cstr)
@@ -347,7 +813,7 @@ static Any rtti_append(void *obj, unsigned arg_count, Any *arguments)
     return Any$VOID;
 }
 
-static Type *append_args[] =
+static const Type *append_args[] =
 {
     &type_string
 };
@@ -367,9 +833,9 @@ static Any rtti_prepend(void *obj, unsigned arg_count, Any *arguments)
     assert(arg_count == 1);
 
     String *this = (String *)obj;
-    if (arguments[0].type == &type_string || arguments[1].type == &type_string_ptr)
+    if (arguments[0].type == &type_string || arguments[0].type == &type_string_ptr)
     {
-        String *rhs = (String *)arguments[0].value.ptr;
+        String *rhs = (String *)Any$data(&arguments[0]);
         String$prepend(this, *rhs);
     }
     else if (arguments[0].type == &type_cstr)
@@ -384,7 +850,7 @@ static Any rtti_prepend(void *obj, unsigned arg_count, Any *arguments)
     return Any$VOID;
 }
 
-static Type *prepend_args[] =
+static const Type *prepend_args[] =
 {
     &type_string
 };
@@ -399,10 +865,46 @@ static Member prepend_member =
     false, // overloaded
 };
 
-static Member *member_list[] =
+static size_t rtti_hash(const void *value)
+{
+    const String *str = (const String *)value;
+    return (size_t)Hash$bytes(String$cstr(str), String$len(str));
+}
+
+static bool rtti_equals(const void *lhs, const void *rhs)
+{
+    return String$equal(*(const String *)lhs, *(const String *)rhs);
+}
+
+static Any rtti_cmp(void *obj, unsigned arg_count, Any *arguments)
+{
+    assert(arg_count == 1);
+    assert(arguments[0].type == &type_string || arguments[0].type == &type_string_ptr);
+
+    const String *rhs = (const String *)Any$data(&arguments[0]);
+    return Any$from_int32(String$compare(*(const String *)obj, *rhs));
+}
+
+static const Type *cmp_args[] =
+{
+    &type_string
+};
+
+static Member cmp_member =
+{
+    ".cmp",
+    rtti_cmp,
+    ARRAY_SIZE(cmp_args), cmp_args, // Args
+    &type_int32_t, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static const Member *member_list[] =
 {
     &constructor_member,
     &destructor_member,
+    &cmp_member,
     &cstr_member,
     &len_member,
     &append_member,
@@ -422,6 +924,8 @@ struct Type type_string =
     0, NULL, // No accessible fields
     ARRAY_SIZE(member_list), member_list,
     0, NULL, // String does not implement any interfaces
+    rtti_hash,
+    rtti_equals,
 };
 
 struct Type type_string_ptr =
@@ -8,8 +8,13 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 typedef struct String String;
+typedef struct StringFormat StringFormat;
+typedef struct StringFormatSegment StringFormatSegment;
+struct Any;
+struct Allocator;
 extern struct String String$EMPTY;
 
 // Construct a String from a "String Literal"
@@ -18,6 +23,12 @@ extern struct String String$EMPTY;
 String String$new();
 String String$copy(const String *this);
 void   String$free(String *this);
+// Keeps its characters in allocator for its whole life, NULL for the heap.
+// String$new and String$copy use Allocator$current(). Strings that don't
+// own a buffer yet, like literals, never adopt a scope and grow on the heap.
+String String$new_in(struct Allocator *allocator, size_t cap);
+// Where the characters live, NULL while the string owns no buffer
+struct Allocator *String$allocator(const String *this);
 
 String      String$from_cstr(const char *str);
 String      String$from_literal(const char *lit);
@@ -25,18 +36,73 @@ const char *String$cstr(const String *this);
 size_t      String$len(const String *this);
 bool        String$equal(String lhs, String rhs);
 int         String$compare(String lhs, String rhs);
+// Only folds ASCII letters
+int         String$compare_nocase(String lhs, String rhs);
+
+// Searches return STRING_NPOS when nothing is found
+#define STRING_NPOS ((size_t)-1)
+size_t String$find(String haystack, String needle);
+size_t String$find_char(String haystack, char c);
+// Position of the first character that appears in charset
+size_t String$find_any(String haystack, String charset);
 
 void String$reserve(String *this, size_t minimum);
 void String$append(String *this, String rhs);
+// Shifts the whole string, use a StringBuilder for repeated prepends
 void String$prepend(String *this, String rhs);
 void String$push(String *this, char c);
 void String$pop(String *this);
 
+// Number appends reserve exactly what they need and format straight
+// into the string, without going through printf
+void String$append_int(String *this, int64_t value);
+void String$append_uint(String *this, uint64_t value);
+// Lowercase, no prefix
+void String$append_hex(String *this, uint64_t value);
+// Shortest round-trip, see Format$double
+void String$append_float(String *this, float value);
+void String$append_double(String *this, double value);
+
+// Formats are parsed once by StringFormat$compile and can then be applied
+// any number of times. {} is replaced by the next argument, {x} by the next
+// integer argument in hex, and {{ and }} stand for single braces. The text
+// isn't copied, so it has to outlive the format, like a string literal does.
+//   StringFormat fmt = StringFormat$compile("{} of {} loaded");
+//   for (...) String$format(&str, &fmt, 2, args);
+#define STRING_FORMAT_MAX_SEGMENTS 32
+StringFormat StringFormat$compile(const char *text);
+// Appends the formatted arguments. Numbers, cstrs and Strings are written
+// directly, and other values the same way Any$print writes them. The whole
+// result is measured first so the string is only grown once. The arguments
+// must not refer to this. Placeholders past arg_count assert, or are left
+// empty when asserts are off.
+void String$format(String *this, const StringFormat *format, unsigned arg_count, const struct Any *args);
+
 extern struct Type type_string;
 extern struct Type type_string_ptr;
+
+// Strings of up to STRING_INLINE_CAP characters are stored inline
+// rather than on the heap, so access the contents through String$cstr
+// and String$len instead of the fields.
+#define STRING_INLINE_CAP (sizeof(String) - 2)
 struct String
 {
     char *data;
     size_t len;
     size_t cap;
 };
+
+struct StringFormatSegment
+{
+    const char *text; // Literal text, or NULL for an argument
+    uint32_t len;
+    bool hex; // For arguments, whether {x} was used
+};
+
+struct StringFormat
+{
+    const char *text;
+    unsigned arg_count;
+    unsigned segment_count;
+    StringFormatSegment segments[STRING_FORMAT_MAX_SEGMENTS];
+};
@@ -0,0 +1,224 @@
+////////////////////////////////////////////
+// File    : string_builder.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "string_builder.h"
+#include "rtti.h"
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define BUILDER_MIN_CAP 64
+
+/////////////////////////////////////
+// StringBuilder
+
+StringBuilder StringBuilder$new(void)
+{
+    StringBuilder builder = { NULL };
+    return builder;
+}
+
+void StringBuilder$free(StringBuilder *this)
+{
+    free(this->buffer);
+    *this = StringBuilder$new();
+}
+
+void StringBuilder$reserve(StringBuilder *this, size_t front, size_t back)
+{
+    size_t len = this->tail - this->head;
+
+    // The tail keeps one byte spare for the NUL terminator
+    if (this->buffer && this->head >= front && this->cap - this->tail > back)
+    {
+        return;
+    }
+
+    // Double at least, then split the slack so whichever end
+    // is being grown gets what it asked for plus half the rest
+    size_t needed = front + len + back + 1;
+    size_t new_cap = this->cap * 2;
+    if (new_cap < needed)
+    {
+        new_cap = needed;
+    }
+    if (new_cap < BUILDER_MIN_CAP)
+    {
+        new_cap = BUILDER_MIN_CAP;
+    }
+
+    size_t new_head = front + (new_cap - needed) / 2;
+    char *buffer = malloc(new_cap);
+    assert(buffer && "Uh oh, memory allocation failed");
+
+    if (this->buffer)
+    {
+        memcpy(buffer + new_head, this->buffer + this->head, len);
+        free(this->buffer);
+    }
+
+    this->buffer = buffer;
+    this->head = new_head;
+    this->tail = new_head + len;
+    this->cap = new_cap;
+    this->buffer[this->tail] = 0;
+}
+
+void StringBuilder$append(StringBuilder *this, String str)
+{
+    size_t len = String$len(&str);
+    StringBuilder$reserve(this, 0, len);
+    memcpy(this->buffer + this->tail, String$cstr(&str), len);
+    this->tail += len;
+    this->buffer[this->tail] = 0;
+}
+
+void StringBuilder$prepend(StringBuilder *this, String str)
+{
+    size_t len = String$len(&str);
+    StringBuilder$reserve(this, len, 0);
+    this->head -= len;
+    memcpy(this->buffer + this->head, String$cstr(&str), len);
+}
+
+void StringBuilder$push(StringBuilder *this, char c)
+{
+    StringBuilder$reserve(this, 0, 1);
+    this->buffer[this->tail++] = c;
+    this->buffer[this->tail] = 0;
+}
+
+size_t StringBuilder$len(const StringBuilder *this)
+{
+    return this->tail - this->head;
+}
+
+const char *StringBuilder$cstr(const StringBuilder *this)
+{
+    if (!this->buffer)
+    {
+        return "";
+    }
+    return this->buffer + this->head;
+}
+
+String StringBuilder$build(StringBuilder *this)
+{
+    String result = String$EMPTY;
+    size_t len = StringBuilder$len(this);
+
+    // Short results fit inline, so copying them is cheapest
+    if (!this->buffer || len <= STRING_INLINE_CAP)
+    {
+        String$append(&result, String$from_literal(StringBuilder$cstr(this)));
+        StringBuilder$free(this);
+        return result;
+    }
+
+    // Otherwise slide the text to the front and hand the buffer over
+    memmove(this->buffer, this->buffer + this->head, len + 1);
+    result.data = this->buffer;
+    result.len = len;
+    result.cap = this->cap;
+
+    this->buffer = NULL;
+    StringBuilder$free(this);
+    return result;
+}
+
+/////////////////////////////////////
+// StringRope
+
+StringRope StringRope$new(void)
+{
+    StringRope rope;
+    rope.front = Vector$new(&type_string);
+    rope.back = Vector$new(&type_string);
+    rope.len = 0;
+    return rope;
+}
+
+void StringRope$free(StringRope *this)
+{
+    Vector$free(&this->front);
+    Vector$free(&this->back);
+    this->len = 0;
+}
+
+void StringRope$append(StringRope *this, String piece)
+{
+    this->len += String$len(&piece);
+    Vector$push(&this->back, &piece);
+}
+
+void StringRope$prepend(StringRope *this, String piece)
+{
+    this->len += String$len(&piece);
+    Vector$push(&this->front, &piece);
+}
+
+size_t StringRope$len(const StringRope *this)
+{
+    return this->len;
+}
+
+static void StringRope$flatten(StringRope *this)
+{
+    if (Vector$len(&this->front) + Vector$len(&this->back) <= 1)
+    {
+        // Already flat, but make sure the piece is in back
+        if (Vector$len(&this->front))
+        {
+            String piece;
+            Vector$pop(&this->front, &piece);
+            Vector$push(&this->back, &piece);
+        }
+        return;
+    }
+
+    StringBuilder builder = StringBuilder$new();
+    StringBuilder$reserve(&builder, 0, this->len);
+
+    const String *front = (const String *)this->front.data;
+    for (size_t i = Vector$len(&this->front); i > 0; --i)
+    {
+        StringBuilder$append(&builder, front[i - 1]);
+    }
+
+    const String *back = (const String *)this->back.data;
+    for (size_t i = 0; i < Vector$len(&this->back); ++i)
+    {
+        StringBuilder$append(&builder, back[i]);
+    }
+
+    String flat = StringBuilder$build(&builder);
+    StringRope$free(this);
+    StringRope$append(this, flat);
+}
+
+const char *StringRope$cstr(StringRope *this)
+{
+    StringRope$flatten(this);
+    if (!Vector$len(&this->back))
+    {
+        return "";
+    }
+    return String$cstr((const String *)this->back.data);
+}
+
+String StringRope$build(StringRope *this)
+{
+    StringRope$flatten(this);
+
+    String result = String$EMPTY;
+    if (Vector$len(&this->back))
+    {
+        Vector$pop(&this->back, &result);
+    }
+
+    StringRope$free(this);
+    return result;
+}
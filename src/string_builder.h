@@ -0,0 +1,66 @@
+////////////////////////////////////////////
+// File    : string_builder.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "string.h"
+#include "vector.h"
+
+typedef struct StringBuilder StringBuilder;
+typedef struct StringRope StringRope;
+
+/////////////////////////////////////
+// StringBuilder
+//
+// A flat buffer with spare room at both ends, so appends
+// and prepends are both amortized O(1).
+
+StringBuilder StringBuilder$new(void);
+void StringBuilder$free(StringBuilder *this);
+
+void   StringBuilder$reserve(StringBuilder *this, size_t front, size_t back);
+void   StringBuilder$append(StringBuilder *this, String str);
+void   StringBuilder$prepend(StringBuilder *this, String str);
+void   StringBuilder$push(StringBuilder *this, char c);
+size_t StringBuilder$len(const StringBuilder *this);
+// Valid until the builder is next modified
+const char *StringBuilder$cstr(const StringBuilder *this);
+// Moves the contents into a String and leaves the builder empty
+String StringBuilder$build(StringBuilder *this);
+
+struct StringBuilder
+{
+    char *buffer;
+    size_t head; // Contents are buffer[head..tail), with a NUL at tail
+    size_t tail;
+    size_t cap;
+};
+
+/////////////////////////////////////
+// StringRope
+//
+// Keeps the pieces it is given and only joins them when the whole
+// text is needed, for very long text assembled from many parts.
+
+StringRope StringRope$new(void);
+void StringRope$free(StringRope *this);
+
+// Both take ownership of piece
+void   StringRope$append(StringRope *this, String piece);
+void   StringRope$prepend(StringRope *this, String piece);
+size_t StringRope$len(const StringRope *this);
+// Flattens the rope into one piece the first time it is called
+// after a modification. Valid until the rope is next modified.
+const char *StringRope$cstr(StringRope *this);
+// Moves the contents into a String and leaves the rope empty
+String StringRope$build(StringRope *this);
+
+struct StringRope
+{
+    Vector front; // Prepended pieces, most recent last
+    Vector back; // Appended pieces, most recent last
+    size_t len;
+};
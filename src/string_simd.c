@@ -0,0 +1,687 @@
+////////////////////////////////////////////
+// File    : string_simd.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "string_simd.h"
+#include "sync.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define STRING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// glibc's memcmp is already vectorized and dispatched, and beats our
+// equal and compare kernels, so only use those on other C runtimes
+#ifndef SIMD_MEMCMP
+#ifdef __GLIBC__
+#define SIMD_MEMCMP 0
+#else
+#define SIMD_MEMCMP 1
+#endif
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_SSE2
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static unsigned ctz32(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+static unsigned char fold_case(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+/////////////////////////////////////
+// Scalar kernels
+
+static bool scalar_equal(const char *lhs, const char *rhs, size_t len)
+{
+    return memcmp(lhs, rhs, len) == 0;
+}
+
+static int scalar_compare(const char *lhs, const char *rhs, size_t len)
+{
+    int result = memcmp(lhs, rhs, len);
+    return (result > 0) - (result < 0);
+}
+
+static int scalar_compare_nocase(const char *lhs, const char *rhs, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned char l = fold_case((unsigned char)lhs[i]);
+        unsigned char r = fold_case((unsigned char)rhs[i]);
+        if (l != r)
+        {
+            return l < r ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static size_t scalar_find_byte(const char *data, size_t len, char c)
+{
+    const char *found = memchr(data, c, len);
+    return found ? (size_t)(found - data) : len;
+}
+
+static size_t scalar_find_any(const char *data, size_t len, const char *set, size_t set_len)
+{
+    uint32_t bitmap[256 / 32] = { 0 };
+    for (size_t i = 0; i < set_len; ++i)
+    {
+        unsigned char c = (unsigned char)set[i];
+        bitmap[c / 32] |= 1u << (c % 32);
+    }
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned char c = (unsigned char)data[i];
+        if (bitmap[c / 32] & (1u << (c % 32)))
+        {
+            return i;
+        }
+    }
+    return len;
+}
+
+static size_t scalar_find(const char *hay, size_t hay_len, const char *needle, size_t needle_len)
+{
+    if (needle_len == 0)
+    {
+        return 0;
+    }
+    if (needle_len > hay_len)
+    {
+        return hay_len;
+    }
+
+    size_t last_start = hay_len - needle_len;
+    size_t i = 0;
+    while (i <= last_start)
+    {
+        size_t found = i + scalar_find_byte(hay + i, last_start + 1 - i, needle[0]);
+        if (found > last_start)
+        {
+            break;
+        }
+        if (memcmp(hay + found + 1, needle + 1, needle_len - 1) == 0)
+        {
+            return found;
+        }
+        i = found + 1;
+    }
+    return hay_len;
+}
+
+static const StringKernels scalar_kernels =
+{
+    SS_SCALAR,
+    "scalar",
+    scalar_equal,
+    scalar_compare,
+    scalar_compare_nocase,
+    scalar_find_byte,
+    scalar_find_any,
+    scalar_find,
+};
+
+#ifdef STRING_SIMD_X86
+
+/////////////////////////////////////
+// SSE2 kernels
+
+#if SIMD_MEMCMP
+
+TARGET_SSE2
+static uint32_t sse2_eq_mask(const char *lhs, const char *rhs)
+{
+    __m128i l = _mm_loadu_si128((const __m128i *)lhs);
+    __m128i r = _mm_loadu_si128((const __m128i *)rhs);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(l, r));
+}
+
+TARGET_SSE2
+static bool sse2_equal_64(const char *lhs, const char *rhs)
+{
+    __m128i eq = _mm_and_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)lhs),
+                                     _mm_loadu_si128((const __m128i *)rhs)),
+                      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(lhs + 16)),
+                                     _mm_loadu_si128((const __m128i *)(rhs + 16)))),
+        _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(lhs + 32)),
+                                     _mm_loadu_si128((const __m128i *)(rhs + 32))),
+                      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(lhs + 48)),
+                                     _mm_loadu_si128((const __m128i *)(rhs + 48)))));
+    return _mm_movemask_epi8(eq) == 0xFFFF;
+}
+
+TARGET_SSE2
+static bool sse2_equal(const char *lhs, const char *rhs, size_t len)
+{
+    if (len < 16)
+    {
+        return memcmp(lhs, rhs, len) == 0;
+    }
+
+    // Four blocks per test keeps the loop bound by loads
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64)
+    {
+        if (!sse2_equal_64(lhs + i, rhs + i))
+        {
+            return false;
+        }
+    }
+
+    for (; i + 16 <= len; i += 16)
+    {
+        if (sse2_eq_mask(lhs + i, rhs + i) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+
+    // Finish with one overlapping block
+    return i == len || sse2_eq_mask(lhs + len - 16, rhs + len - 16) == 0xFFFF;
+}
+
+TARGET_SSE2
+static int sse2_compare(const char *lhs, const char *rhs, size_t len)
+{
+    // Skip the equal prefix quickly, then find the byte a block at a time
+    size_t i = 0;
+    while (i + 64 <= len && sse2_equal_64(lhs + i, rhs + i))
+    {
+        i += 64;
+    }
+
+    for (; i + 16 <= len; i += 16)
+    {
+        uint32_t diff = sse2_eq_mask(lhs + i, rhs + i) ^ 0xFFFF;
+        if (diff)
+        {
+            size_t at = i + ctz32(diff);
+            return (unsigned char)lhs[at] < (unsigned char)rhs[at] ? -1 : 1;
+        }
+    }
+    return scalar_compare(lhs + i, rhs + i, len - i);
+}
+
+#endif
+
+TARGET_SSE2
+static __m128i sse2_fold_case(__m128i bytes)
+{
+    // Bytes past 0x7F are negative as signed, so they are never in range
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(bytes, _mm_set1_epi8('Z' + 1)));
+    return _mm_add_epi8(bytes, _mm_and_si128(upper, _mm_set1_epi8('a' - 'A')));
+}
+
+TARGET_SSE2
+static int sse2_compare_nocase(const char *lhs, const char *rhs, size_t len)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i l = sse2_fold_case(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        __m128i r = sse2_fold_case(_mm_loadu_si128((const __m128i *)(rhs + i)));
+        uint32_t diff = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)) ^ 0xFFFF;
+        if (diff)
+        {
+            size_t at = i + ctz32(diff);
+            return fold_case((unsigned char)lhs[at]) < fold_case((unsigned char)rhs[at]) ? -1 : 1;
+        }
+    }
+    return scalar_compare_nocase(lhs + i, rhs + i, len - i);
+}
+
+TARGET_SSE2
+static size_t sse2_find_byte(const char *data, size_t len, char c)
+{
+    __m128i needle = _mm_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64)
+    {
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), needle),
+                         _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 16)), needle)),
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 32)), needle),
+                         _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + 48)), needle)));
+        if (_mm_movemask_epi8(hits))
+        {
+            break;
+        }
+    }
+
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask)
+        {
+            return i + ctz32(mask);
+        }
+    }
+    return i + scalar_find_byte(data + i, len - i, c);
+}
+
+TARGET_SSE2
+static size_t sse2_find_any(const char *data, size_t len, const char *set, size_t set_len)
+{
+    // One compare per set member only pays off for small sets
+    if (set_len == 0 || set_len > 16)
+    {
+        return scalar_find_any(data, len, set, set_len);
+    }
+
+    __m128i members[16];
+    for (size_t j = 0; j < set_len; ++j)
+    {
+        members[j] = _mm_set1_epi8(set[j]);
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i hits = _mm_setzero_si128();
+        for (size_t j = 0; j < set_len; ++j)
+        {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, members[j]));
+        }
+
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+        if (mask)
+        {
+            return i + ctz32(mask);
+        }
+    }
+    return i + scalar_find_any(data + i, len - i, set, set_len);
+}
+
+TARGET_SSE2
+static size_t sse2_find(const char *hay, size_t hay_len, const char *needle, size_t needle_len)
+{
+    if (needle_len == 0 || needle_len > hay_len)
+    {
+        return needle_len == 0 ? 0 : hay_len;
+    }
+    if (needle_len == 1)
+    {
+        return sse2_find_byte(hay, hay_len, needle[0]);
+    }
+
+    // Filter candidates on the first and last needle bytes,
+    // then confirm the middle with memcmp
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+    size_t i = 0;
+    for (; i + needle_len - 1 + 16 <= hay_len; i += 16)
+    {
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(hay + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i *)(hay + i + needle_len - 1));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                          _mm_cmpeq_epi8(block_last, last)));
+
+        while (mask)
+        {
+            size_t at = i + ctz32(mask);
+            if (memcmp(hay + at + 1, needle + 1, needle_len - 2) == 0)
+            {
+                return at;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    size_t rest = scalar_find(hay + i, hay_len - i, needle, needle_len);
+    return rest == hay_len - i ? hay_len : i + rest;
+}
+
+static const StringKernels sse2_kernels =
+{
+    SS_SSE2,
+    "sse2",
+#if SIMD_MEMCMP
+    sse2_equal,
+    sse2_compare,
+#else
+    scalar_equal,
+    scalar_compare,
+#endif
+    sse2_compare_nocase,
+    sse2_find_byte,
+    sse2_find_any,
+    sse2_find,
+};
+
+/////////////////////////////////////
+// AVX2 kernels
+
+#if SIMD_MEMCMP
+
+TARGET_AVX2
+static uint32_t avx2_eq_mask(const char *lhs, const char *rhs)
+{
+    __m256i l = _mm256_loadu_si256((const __m256i *)lhs);
+    __m256i r = _mm256_loadu_si256((const __m256i *)rhs);
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r));
+}
+
+TARGET_AVX2
+static bool avx2_equal_128(const char *lhs, const char *rhs)
+{
+    __m256i eq = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)lhs),
+                                           _mm256_loadu_si256((const __m256i *)rhs)),
+                         _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(lhs + 32)),
+                                           _mm256_loadu_si256((const __m256i *)(rhs + 32)))),
+        _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(lhs + 64)),
+                                           _mm256_loadu_si256((const __m256i *)(rhs + 64))),
+                         _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(lhs + 96)),
+                                           _mm256_loadu_si256((const __m256i *)(rhs + 96)))));
+    return (uint32_t)_mm256_movemask_epi8(eq) == 0xFFFFFFFFu;
+}
+
+TARGET_AVX2
+static bool avx2_equal(const char *lhs, const char *rhs, size_t len)
+{
+    if (len < 32)
+    {
+        return sse2_equal(lhs, rhs, len);
+    }
+
+    size_t i = 0;
+    for (; i + 128 <= len; i += 128)
+    {
+        if (!avx2_equal_128(lhs + i, rhs + i))
+        {
+            return false;
+        }
+    }
+
+    for (; i + 32 <= len; i += 32)
+    {
+        if (avx2_eq_mask(lhs + i, rhs + i) != 0xFFFFFFFFu)
+        {
+            return false;
+        }
+    }
+
+    return i == len || avx2_eq_mask(lhs + len - 32, rhs + len - 32) == 0xFFFFFFFFu;
+}
+
+TARGET_AVX2
+static int avx2_compare(const char *lhs, const char *rhs, size_t len)
+{
+    size_t i = 0;
+    while (i + 128 <= len && avx2_equal_128(lhs + i, rhs + i))
+    {
+        i += 128;
+    }
+
+    for (; i + 32 <= len; i += 32)
+    {
+        uint32_t diff = ~avx2_eq_mask(lhs + i, rhs + i);
+        if (diff)
+        {
+            size_t at = i + ctz32(diff);
+            return (unsigned char)lhs[at] < (unsigned char)rhs[at] ? -1 : 1;
+        }
+    }
+
+    // Clear the upper halves before running SSE code,
+    // mixing them costs far more than the tail itself
+    _mm256_zeroupper();
+    return sse2_compare(lhs + i, rhs + i, len - i);
+}
+
+#endif
+
+TARGET_AVX2
+static __m256i avx2_fold_case(__m256i bytes)
+{
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), bytes));
+    return _mm256_add_epi8(bytes, _mm256_and_si256(upper, _mm256_set1_epi8('a' - 'A')));
+}
+
+TARGET_AVX2
+static int avx2_compare_nocase(const char *lhs, const char *rhs, size_t len)
+{
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i l = avx2_fold_case(_mm256_loadu_si256((const __m256i *)(lhs + i)));
+        __m256i r = avx2_fold_case(_mm256_loadu_si256((const __m256i *)(rhs + i)));
+        uint32_t diff = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r));
+        if (diff)
+        {
+            size_t at = i + ctz32(diff);
+            return fold_case((unsigned char)lhs[at]) < fold_case((unsigned char)rhs[at]) ? -1 : 1;
+        }
+    }
+    _mm256_zeroupper();
+    return sse2_compare_nocase(lhs + i, rhs + i, len - i);
+}
+
+TARGET_AVX2
+static size_t avx2_find_byte(const char *data, size_t len, char c)
+{
+    __m256i needle = _mm256_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 128 <= len; i += 128)
+    {
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), needle),
+                            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 32)), needle)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 64)), needle),
+                            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + 96)), needle)));
+        if (_mm256_movemask_epi8(hits))
+        {
+            break;
+        }
+    }
+
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask)
+        {
+            return i + ctz32(mask);
+        }
+    }
+
+    _mm256_zeroupper();
+    return i + sse2_find_byte(data + i, len - i, c);
+}
+
+TARGET_AVX2
+static size_t avx2_find_any(const char *data, size_t len, const char *set, size_t set_len)
+{
+    if (set_len == 0 || set_len > 16)
+    {
+        return scalar_find_any(data, len, set, set_len);
+    }
+
+    __m256i members[16];
+    for (size_t j = 0; j < set_len; ++j)
+    {
+        members[j] = _mm256_set1_epi8(set[j]);
+    }
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i hits = _mm256_setzero_si256();
+        for (size_t j = 0; j < set_len; ++j)
+        {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, members[j]));
+        }
+
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+        if (mask)
+        {
+            return i + ctz32(mask);
+        }
+    }
+    _mm256_zeroupper();
+    return i + sse2_find_any(data + i, len - i, set, set_len);
+}
+
+TARGET_AVX2
+static size_t avx2_find(const char *hay, size_t hay_len, const char *needle, size_t needle_len)
+{
+    if (needle_len == 0 || needle_len > hay_len)
+    {
+        return needle_len == 0 ? 0 : hay_len;
+    }
+    if (needle_len == 1)
+    {
+        return avx2_find_byte(hay, hay_len, needle[0]);
+    }
+
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    size_t i = 0;
+    for (; i + needle_len - 1 + 32 <= hay_len; i += 32)
+    {
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(hay + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i *)(hay + i + needle_len - 1));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                             _mm256_cmpeq_epi8(block_last, last)));
+
+        while (mask)
+        {
+            size_t at = i + ctz32(mask);
+            if (memcmp(hay + at + 1, needle + 1, needle_len - 2) == 0)
+            {
+                return at;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    _mm256_zeroupper();
+    size_t rest = sse2_find(hay + i, hay_len - i, needle, needle_len);
+    return rest == hay_len - i ? hay_len : i + rest;
+}
+
+static const StringKernels avx2_kernels =
+{
+    SS_AVX2,
+    "avx2",
+#if SIMD_MEMCMP
+    avx2_equal,
+    avx2_compare,
+#else
+    scalar_equal,
+    scalar_compare,
+#endif
+    avx2_compare_nocase,
+    avx2_find_byte,
+    avx2_find_any,
+    avx2_find,
+};
+
+static StringSimd StringKernels$detect(void)
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) &&
+                        ((_xgetbv(0) & 6) == 6);
+    __cpuidex(info, 7, 0);
+    if (os_saves_ymm && (info[1] & (1 << 5)))
+    {
+        return SS_AVX2;
+    }
+    // SSE2 is part of the baseline for every x86 target MSVC builds for
+    return SS_SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SS_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return SS_SSE2;
+    }
+    return SS_SCALAR;
+#endif
+}
+
+#else
+
+static StringSimd StringKernels$detect(void)
+{
+    return SS_SCALAR;
+}
+
+#endif
+
+static const StringKernels *StringKernels$for_level(StringSimd level)
+{
+    switch (level)
+    {
+#ifdef STRING_SIMD_X86
+        case SS_AVX2: return &avx2_kernels;
+        case SS_SSE2: return &sse2_kernels;
+#endif
+        default: return &scalar_kernels;
+    }
+}
+
+static const StringKernels *string_kernels;
+static StringSimd string_best_level = (StringSimd)-1;
+
+const StringKernels *StringKernels$get(void)
+{
+    const StringKernels *kernels = Atomic$load_ptr((void *volatile *)&string_kernels);
+    if (!kernels)
+    {
+        // Racing threads all detect the same thing, so last write wins
+        kernels = StringKernels$for_level(StringKernels$set_level(SS_AVX2));
+    }
+    return kernels;
+}
+
+StringSimd StringKernels$set_level(StringSimd level)
+{
+    if (string_best_level == (StringSimd)-1)
+    {
+        string_best_level = StringKernels$detect();
+    }
+    if (level > string_best_level)
+    {
+        level = string_best_level;
+    }
+
+    Atomic$store_ptr((void *volatile *)&string_kernels, (void *)StringKernels$for_level(level));
+    return level;
+}
@@ -0,0 +1,45 @@
+////////////////////////////////////////////
+// File    : string_simd.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Byte kernels behind the String search and comparison functions.
+// Every kernel works on explicit lengths and ignores NULs.
+
+typedef enum StringSimd StringSimd;
+typedef struct StringKernels StringKernels;
+
+enum StringSimd
+{
+    SS_SCALAR,
+    SS_SSE2,
+    SS_AVX2,
+};
+
+// The kernels for the best level the CPU supports, picked on first use
+const StringKernels *StringKernels$get(void);
+// Force a lower level, mainly for benchmarks. Levels the CPU can't
+// run are clamped to the best one it can. Returns the level used.
+StringSimd StringKernels$set_level(StringSimd level);
+
+struct StringKernels
+{
+    StringSimd level;
+    const char *name;
+
+    bool   (*equal)(const char *lhs, const char *rhs, size_t len);
+    // Sign of the first differing byte, compared as unsigned
+    int    (*compare)(const char *lhs, const char *rhs, size_t len);
+    // Same as compare, with ASCII letters folded to lower case
+    int    (*compare_nocase)(const char *lhs, const char *rhs, size_t len);
+    // These return len (or hay_len) when nothing is found
+    size_t (*find_byte)(const char *data, size_t len, char c);
+    size_t (*find_any)(const char *data, size_t len, const char *set, size_t set_len);
+    size_t (*find)(const char *hay, size_t hay_len, const char *needle, size_t needle_len);
+};
@@ -0,0 +1,139 @@
+////////////////////////////////////////////
+// File    : sync.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/////////////////////////////////////
+// Thread-local storage
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+/////////////////////////////////////
+// Atomics
+//
+// Loads acquire, stores release, and read-modify-write
+// operations are full barriers.
+
+static inline intptr_t Atomic$load(volatile intptr_t *ptr)
+{
+#ifdef _MSC_VER
+    intptr_t value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void Atomic$store(volatile intptr_t *ptr, intptr_t value)
+{
+#ifdef _MSC_VER
+    _ReadWriteBarrier();
+    *ptr = value;
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+// Returns the new value
+static inline intptr_t Atomic$add(volatile intptr_t *ptr, intptr_t delta)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    return _InterlockedExchangeAdd64(ptr, delta) + delta;
+#elif defined(_MSC_VER)
+    return _InterlockedExchangeAdd((volatile long *)ptr, delta) + delta;
+#else
+    return __atomic_add_fetch(ptr, delta, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline bool Atomic$cas(volatile intptr_t *ptr, intptr_t expected, intptr_t desired)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    return _InterlockedCompareExchange64(ptr, desired, expected) == expected;
+#elif defined(_MSC_VER)
+    return _InterlockedCompareExchange((volatile long *)ptr, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline void *Atomic$load_ptr(void *volatile *ptr)
+{
+    return (void *)Atomic$load((volatile intptr_t *)ptr);
+}
+
+static inline void Atomic$store_ptr(void *volatile *ptr, void *value)
+{
+    Atomic$store((volatile intptr_t *)ptr, (intptr_t)value);
+}
+
+static inline bool Atomic$cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+    return Atomic$cas((volatile intptr_t *)ptr, (intptr_t)expected, (intptr_t)desired);
+}
+
+// Raises *ptr to value if it is currently lower
+static inline void Atomic$max(volatile intptr_t *ptr, intptr_t value)
+{
+    intptr_t current = Atomic$load(ptr);
+    while (current < value && !Atomic$cas(ptr, current, value))
+    {
+        current = Atomic$load(ptr);
+    }
+}
+
+// Full barrier, for the rare algorithm that needs a store to be visible
+// before a later load, like a Chase-Lev deque
+static inline void Atomic$fence(void)
+{
+#ifdef _MSC_VER
+    _mm_mfence();
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline void Atomic$pause(void)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/////////////////////////////////////
+// Spin locks, only for short critical sections
+
+typedef volatile intptr_t SpinLock;
+
+#define SPINLOCK_INIT 0
+
+static inline void SpinLock$lock(SpinLock *this)
+{
+    while (!Atomic$cas(this, 0, 1))
+    {
+        while (Atomic$load(this))
+        {
+            Atomic$pause();
+        }
+    }
+}
+
+static inline void SpinLock$unlock(SpinLock *this)
+{
+    Atomic$store(this, 0);
+}
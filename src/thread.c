@@ -0,0 +1,177 @@
+////////////////////////////////////////////
+// File    : thread.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "thread.h"
+#include <stdlib.h>
+#include <assert.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+struct Thread
+{
+    ThreadFunc func;
+    void *arg;
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+};
+
+struct Semaphore
+{
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned count;
+#endif
+};
+
+/////////////////////////////////////
+// Threads
+
+#ifdef _WIN32
+static DWORD WINAPI Thread$main(LPVOID param)
+{
+    Thread *thread = (Thread *)param;
+    thread->func(thread->arg);
+    return 0;
+}
+#else
+static void *Thread$main(void *param)
+{
+    Thread *thread = (Thread *)param;
+    thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+Thread *Thread$spawn(ThreadFunc func, void *arg)
+{
+    Thread *thread = malloc(sizeof(Thread));
+    assert(thread && "Uh oh, failed to allocate memory!");
+    thread->func = func;
+    thread->arg = arg;
+
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, Thread$main, thread, 0, NULL);
+    assert(thread->handle && "Uh oh, failed to create a thread!");
+#else
+    int result = pthread_create(&thread->handle, NULL, Thread$main, thread);
+    assert(result == 0 && "Uh oh, failed to create a thread!");
+    (result); // unreferenced when asserts are off
+#endif
+    return thread;
+}
+
+void Thread$join(Thread *thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
+void Thread$yield(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+unsigned Thread$cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (unsigned)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned)count : 1;
+#endif
+}
+
+/////////////////////////////////////
+// Semaphores
+
+Semaphore *Semaphore$new(unsigned count)
+{
+    Semaphore *this = malloc(sizeof(Semaphore));
+    assert(this && "Uh oh, failed to allocate memory!");
+
+#ifdef _WIN32
+    this->handle = CreateSemaphore(NULL, (LONG)count, MAXLONG, NULL);
+    assert(this->handle && "Uh oh, failed to create a semaphore!");
+#else
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->cond, NULL);
+    this->count = count;
+#endif
+    return this;
+}
+
+void Semaphore$free(Semaphore *this)
+{
+#ifdef _WIN32
+    CloseHandle(this->handle);
+#else
+    pthread_cond_destroy(&this->cond);
+    pthread_mutex_destroy(&this->mutex);
+#endif
+    free(this);
+}
+
+void Semaphore$post(Semaphore *this, unsigned count)
+{
+#ifdef _WIN32
+    ReleaseSemaphore(this->handle, (LONG)count, NULL);
+#else
+    pthread_mutex_lock(&this->mutex);
+    this->count += count;
+    if (count == 1)
+    {
+        pthread_cond_signal(&this->cond);
+    }
+    else
+    {
+        pthread_cond_broadcast(&this->cond);
+    }
+    pthread_mutex_unlock(&this->mutex);
+#endif
+}
+
+void Semaphore$wait(Semaphore *this)
+{
+#ifdef _WIN32
+    WaitForSingleObject(this->handle, INFINITE);
+#else
+    pthread_mutex_lock(&this->mutex);
+    while (!this->count)
+    {
+        pthread_cond_wait(&this->cond, &this->mutex);
+    }
+    this->count--;
+    pthread_mutex_unlock(&this->mutex);
+#endif
+}
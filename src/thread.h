@@ -0,0 +1,22 @@
+////////////////////////////////////////////
+// File    : thread.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+typedef struct Thread Thread;
+typedef struct Semaphore Semaphore;
+typedef void (*ThreadFunc)(void *arg);
+
+Thread  *Thread$spawn(ThreadFunc func, void *arg);
+// Waits for the thread to finish and frees it
+void     Thread$join(Thread *thread);
+void     Thread$yield(void);
+unsigned Thread$cpu_count(void);
+
+Semaphore *Semaphore$new(unsigned count);
+void       Semaphore$free(Semaphore *this);
+void       Semaphore$post(Semaphore *this, unsigned count);
+void       Semaphore$wait(Semaphore *this);
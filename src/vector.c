@@ -1,40 +1,53 @@
 #include "vector.h"
 #include "rtti.h"
+#include "allocator.h"
+#include "vector_map.h"
+#include "writer.h"
+#include "helpers.h"
 #include <string.h>
+#include <assert.h>
 
 static void *Vector$mem_idx(const Vector *this, size_t idx);
 static void Vector$grow(Vector *this, size_t minimum);
+static void Vector$copy_items(const Type *type, void *dest, const void *src, size_t count);
+static void Vector$destroy_items(const Type *type, void *items, size_t count);
+static bool Vector$aliases(const Vector *this, const void *items, size_t *offset);
 
 Vector Vector$new(const Type *member_type)
 {
     Vector vec = { NULL };
     vec.member_type = member_type;
+    vec.allocator = Allocator$current();
+    return vec;
+}
+
+Vector Vector$new_in(const Type *member_type, Allocator *allocator)
+{
+    Vector vec = { NULL };
+    vec.member_type = member_type;
+    vec.allocator = allocator;
     return vec;
 }
 
 Vector Vector$copy(const Vector *vec)
 {
     Vector copy = Vector$new(vec->member_type);
-    Vector$reserve(&copy, vec->len);
-    for (size_t i = 0; i < vec->len; ++i)
-    {
-        Any obj = Any$ref_complex(vec->member_type, Vector$mem_idx(vec, i));
-        Any item = Any$copy(obj);
-        Vector$push(&copy, item.value.ptr);
-        Any$soft_release(&item);
-    }
+    Vector$extend(&copy, vec);
     return copy;
 }
 
 void Vector$free(Vector *this)
 {
-    for (size_t i = 0; i < this->len; ++i)
+    Vector$destroy_items(this->member_type, this->data, this->len);
+
+    if (this->mapping)
     {
-        Any obj = Any$ref_complex(this->member_type, Vector$mem_idx(this, i));
-        Any$delete_ref(&obj);
+        Vector$unmap(this);
+    }
+    else
+    {
+        Allocator$free(this->allocator, this->data, this->cap * this->member_type->size);
     }
-
-    free(this->data);
     this->data = NULL;
     this->len = 0;
     this->cap = 0;
@@ -47,16 +60,75 @@ size_t Vector$len(const Vector *this)
 
 void Vector$print(const Vector *this, FILE *stream)
 {
-    fputs("[", stream);
+    char buffer[1024];
+    Writer writer = Writer$to_file(stream, buffer, sizeof(buffer));
+    Vector$write(this, &writer);
+    Writer$char(&writer, '\n');
+    Writer$close(&writer);
+}
+
+// Primitive elements are formatted directly, skipping the Any for each one
+#define VECTOR_WRITE_ITEMS(T, write_item)                       \
+    {                                                           \
+        const T *items = (const T *)this->data;                 \
+        for (size_t i = 0; i < this->len; ++i)                  \
+        {                                                       \
+            if (i) { Writer$write(writer, ", ", 2); }           \
+            write_item(writer, items[i]);                       \
+        }                                                       \
+    }
+
+void Vector$write(const Vector *this, Writer *writer)
+{
+    const Type *type = this->member_type;
+    Writer$char(writer, '[');
 
-    for (size_t i = 0; i < this->len; ++i)
+    if (type == &type_int32_t) VECTOR_WRITE_ITEMS(int32_t, Writer$int)
+    else if (type == &type_uint32_t) VECTOR_WRITE_ITEMS(uint32_t, Writer$uint)
+    else if (type == &type_int64_t) VECTOR_WRITE_ITEMS(int64_t, Writer$int)
+    else if (type == &type_uint64_t) VECTOR_WRITE_ITEMS(uint64_t, Writer$uint)
+    else if (type == &type_float) VECTOR_WRITE_ITEMS(float, Writer$float)
+    else if (type == &type_double) VECTOR_WRITE_ITEMS(double, Writer$double)
+    else
     {
-        Any obj = Any$ref_complex(this->member_type, Vector$mem_idx(this, i));
-        Any$print(obj, stream);
-        if (i + 1 < this->len) { fputs(", ", stream); }
+        for (size_t i = 0; i < this->len; ++i)
+        {
+            // Primitives and pointers are held by value
+            void *item = Vector$mem_idx(this, i);
+            Any obj = { type };
+            if (type->kind == TK_COMPLEX)
+            {
+                obj = Any$ref_complex(type, item);
+            }
+            else
+            {
+                memcpy(&obj.value, item, type->size);
+            }
+
+            if (i) { Writer$write(writer, ", ", 2); }
+            Any$write(obj, writer);
+        }
     }
 
-    fputs("]\n", stream);
+    Writer$char(writer, ']');
+}
+
+bool Vector$invoke_each(Vector *this, const char *member_name,
+                        unsigned arg_count, Any *args, Any *results)
+{
+    const Member *member = Type$find_member(this->member_type, member_name);
+    if (!member)
+    {
+        for (unsigned i = 0; i < arg_count; ++i)
+        {
+            Any$free(&args[i]);
+        }
+        return false;
+    }
+
+    Member$invoke_batch(member, this->data, this->member_type->size, this->len,
+                        arg_count, args, results);
+    return true;
 }
 
 void Vector$reserve(Vector *this, size_t cap)
@@ -78,6 +150,165 @@ void Vector$pop(Vector *this, void *result)
     memcpy(result, Vector$mem_idx(this, --this->len), this->member_type->size);
 }
 
+void Vector$push_n(Vector *this, const void *items, size_t count)
+{
+    size_t offset = 0;
+    bool aliased = Vector$aliases(this, items, &offset);
+    Vector$reserve(this, this->len + count);
+    if (aliased)
+    {
+        items = (char *)this->data + offset;
+    }
+    if (count)
+    {
+        memcpy(Vector$mem_idx(this, this->len), items, count * this->member_type->size);
+    }
+    this->len += count;
+}
+
+void Vector$extend(Vector *this, const Vector *other)
+{
+    assert(this->member_type == other->member_type && "Vector$extend needs matching member types");
+
+    size_t count = other->len;
+    Vector$reserve(this, this->len + count);
+    Vector$copy_items(this->member_type, Vector$mem_idx(this, this->len), other->data, count);
+    this->len += count;
+}
+
+void Vector$insert_range(Vector *this, size_t index, const void *items, size_t count)
+{
+    assert(index <= this->len && "Vector$insert_range index out of range");
+
+    size_t size = this->member_type->size;
+    size_t offset = 0;
+    bool aliased = Vector$aliases(this, items, &offset);
+    Vector$reserve(this, this->len + count);
+    if (count)
+    {
+        char *at = Vector$mem_idx(this, index);
+        size_t bytes = count * size;
+        memmove(at + bytes, at, (this->len - index) * size);
+        if (!aliased)
+        {
+            memcpy(at, items, bytes);
+        }
+        else
+        {
+            // Items in front of index stayed where they were,
+            // and the rest moved up with the tail
+            char *data = this->data;
+            size_t split = index * size;
+            size_t before = offset < split ? split - offset : 0;
+            if (before > bytes)
+            {
+                before = bytes;
+            }
+            memcpy(at, data + offset, before);
+            memcpy(at + before, data + offset + before + bytes, bytes - before);
+        }
+    }
+    this->len += count;
+}
+
+void Vector$remove_range(Vector *this, size_t index, size_t count)
+{
+    assert(index <= this->len && count <= this->len - index && "Vector$remove_range out of range");
+
+    Vector$destroy_items(this->member_type, Vector$mem_idx(this, index), count);
+    if (count)
+    {
+        memmove(Vector$mem_idx(this, index), Vector$mem_idx(this, index + count),
+                (this->len - index - count) * this->member_type->size);
+    }
+    this->len -= count;
+}
+
+void Vector$drain(Vector *this, size_t index, size_t count, Vector *into)
+{
+    assert(index <= this->len && count <= this->len - index && "Vector$drain out of range");
+    assert(this != into && this->member_type == into->member_type);
+
+    // The elements change owners, so they're moved without being copied or destroyed
+    Vector$push_n(into, Vector$mem_idx(this, index), count);
+    if (count)
+    {
+        memmove(Vector$mem_idx(this, index), Vector$mem_idx(this, index + count),
+                (this->len - index - count) * this->member_type->size);
+    }
+    this->len -= count;
+}
+
+void Vector$splice(Vector *this, size_t index, size_t remove_count, Vector *from)
+{
+    assert(index <= this->len && remove_count <= this->len - index && "Vector$splice out of range");
+    assert(this != from && this->member_type == from->member_type);
+
+    size_t size = this->member_type->size;
+    size_t tail = this->len - index - remove_count;
+    Vector$destroy_items(this->member_type, Vector$mem_idx(this, index), remove_count);
+
+    // Shift the tail once, straight to where it ends up
+    Vector$reserve(this, index + from->len + tail);
+    if (tail)
+    {
+        memmove(Vector$mem_idx(this, index + from->len), Vector$mem_idx(this, index + remove_count),
+                tail * size);
+    }
+    if (from->len)
+    {
+        memcpy(Vector$mem_idx(this, index), from->data, from->len * size);
+    }
+
+    this->len = index + from->len + tail;
+    from->len = 0;
+}
+
+static void Vector$copy_items(const Type *type, void *dest, const void *src, size_t count)
+{
+    // Plain data copies as one block
+    if (Type$has_traits(type, TT_TRIVIAL_COPY))
+    {
+        if (count)
+        {
+            memcpy(dest, src, count * type->size);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Type$copy_value(type, (char *)dest + i * type->size, (const char *)src + i * type->size);
+    }
+}
+
+static void Vector$destroy_items(const Type *type, void *items, size_t count)
+{
+    if (Type$has_traits(type, TT_TRIVIAL_DESTROY))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Type$destroy_value(type, (char *)items + i * type->size);
+    }
+}
+
+// Items pointing into this vector's own elements are found again by
+// offset after reserving, which may move them
+static bool Vector$aliases(const Vector *this, const void *items, size_t *offset)
+{
+    uintptr_t start = (uintptr_t)this->data;
+    uintptr_t at = (uintptr_t)items;
+    if (!this->data || at < start || at >= start + this->len * this->member_type->size)
+    {
+        return false;
+    }
+    *offset = (size_t)(at - start);
+    return true;
+}
+
 static void *Vector$mem_idx(const Vector *this, size_t idx)
 {
     return &((char *)this->data)[idx * this->member_type->size];
@@ -96,13 +327,115 @@ void Vector$grow(Vector *this, size_t minimum)
         new_cap = minimum;
     }
 
-    size_t new_size = new_cap * this->member_type->size;
-    if (this->data)
+    if (this->mapping)
     {
-        this->data = realloc(this->data, new_size);
+        Vector$grow_mapped(this, new_cap);
+        return;
+    }
+
+    size_t size = this->member_type->size;
+    this->data = Allocator$realloc(this->allocator, this->data, this->cap * size,
+                                   new_cap * size, this->member_type->alignment);
+    this->cap = new_cap;
+}
+
+/////////////////////////////////////
+// RTTI
+
+static Any rtti_constructor(void *obj, unsigned arg_count, Any *arguments)
+{
+    (obj); // unreferenced parameter
+    if (arg_count != 1) // Invalid
+    {
+        return Any$EMPTY;
+    }
+
+    // Element type
+    if (arguments[0].type == &type_type_ptr)
+    {
+        Vector temp = Vector$new((const Type *)arguments[0].value.ptr);
+        return Any$from_complex(&type_vector, &temp);
+    }
+
+    // Copy constructor
+    assert(arguments[0].type == &type_vector);
+    Vector temp;
+    if (arguments[0].storage == AS_REF)
+    {
+        temp = Vector$copy((const Vector *)Any$data(&arguments[0]));
     }
     else
     {
-        this->data = malloc(new_size);
+        Any$unpack(arguments[0], &temp);
+        Any$soft_release(&arguments[0]);
     }
+    return Any$from_complex(&type_vector, &temp);
 }
+
+static Member constructor_member =
+{
+    ".ctor",
+    rtti_constructor,
+    1, // Number of args
+    NULL, // Argument types; a Vector to copy, or the member Type*
+    &type_vector, // Return type
+    true, // static
+    false, // overloaded
+};
+
+static Any rtti_destructor(void *obj, unsigned arg_count, Any *arguments)
+{
+    (arguments); // unreferenced parameter
+    assert(arg_count == 0);
+    Vector$free((Vector *)obj);
+    return Any$VOID;
+}
+
+static Member destructor_member =
+{
+    ".dtor",
+    rtti_destructor,
+    0, // Number of args
+    NULL, // No arguments
+    &type_void, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static Any rtti_len(void *obj, unsigned arg_count, Any *arguments)
+{
+    (arg_count, arguments); // unreferenced parameters
+    return Any$from_size_t(Vector$len((const Vector *)obj));
+}
+
+static Member len_member =
+{
+    "len",
+    rtti_len,
+    0, NULL, // Args
+    &type_size_t, // Return type
+    false, // static
+    false, // overloaded
+};
+
+static const Member *member_list[] =
+{
+    &constructor_member,
+    &destructor_member,
+    &len_member,
+};
+
+struct Type type_vector =
+{
+    TK_COMPLEX,
+    sizeof(Vector), // Size
+    sizeof(void *), // Alignment
+    "Vector", // Name
+    NULL, // Subtype
+    &constructor_member,
+    &destructor_member,
+
+    0, NULL, // No accessible fields
+    ARRAY_SIZE(member_list), member_list,
+    0, NULL, // Vector does not implement any interfaces
+};
@@ -6,23 +6,54 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
 
 typedef struct Vector Vector;
 struct Type;
+struct Any;
+struct Allocator;
+struct VectorMapping;
+struct Writer;
 
+// Keeps its data in Allocator$current(), which is the active arena if there is one
 Vector Vector$new(const struct Type *member_type);
+// Keeps its data in allocator for its whole life, NULL for the heap
+Vector Vector$new_in(const struct Type *member_type, struct Allocator *allocator);
 Vector Vector$copy(const Vector *vec);
 void   Vector$free(Vector *this);
 
 size_t Vector$len(const Vector *this);
 void Vector$print(const Vector *this, FILE *stream);
+void Vector$write(const Vector *this, struct Writer *writer);
+
+// Invokes the named member on every element, looking it up only once.
+// See Member$invoke_batch, results is NULL or has room for len results.
+// args are always freed. Returns false if the elements have no such member.
+bool Vector$invoke_each(Vector *this, const char *member_name,
+                        unsigned arg_count, struct Any *args, struct Any *results);
 
 void Vector$reserve(Vector *this, size_t cap);
 void Vector$push(Vector *this, void *item);
 void Vector$pop(Vector *this, void *result);
 
+// Bulk operations reserve once and move each block with one memmove.
+// Like Vector$push, the raw item versions take ownership of the items.
+// Items may point into this same vector, as for plain data re-inserting
+// one of its own ranges.
+void Vector$push_n(Vector *this, const void *items, size_t count);
+// Appends copies of every element in other
+void Vector$extend(Vector *this, const Vector *other);
+void Vector$insert_range(Vector *this, size_t index, const void *items, size_t count);
+// Destroys the removed elements
+void Vector$remove_range(Vector *this, size_t index, size_t count);
+// Moves the range to the end of into
+void Vector$drain(Vector *this, size_t index, size_t count, Vector *into);
+// Replaces remove_count elements at index with every element of from,
+// which is left empty
+void Vector$splice(Vector *this, size_t index, size_t remove_count, Vector *from);
+
 extern struct Type type_vector;
 struct Vector
 {
@@ -30,4 +61,6 @@ struct Vector
     void *data;
     size_t len;
     size_t cap;
+    struct Allocator *allocator; // Owner of data, NULL for the heap
+    struct VectorMapping *mapping; // Owner of data if it's in a mapped file, see vector_map.h
 };
@@ -0,0 +1,339 @@
+////////////////////////////////////////////
+// File    : vector_map.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "vector_map.h"
+#include "rtti.h"
+#include "serialize.h"
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// "VFIL"
+#define VECTOR_FILE_MAGIC 0x4C494656u
+
+typedef struct VectorFileHeader VectorFileHeader;
+typedef struct VectorMapping VectorMapping;
+
+struct VectorFileHeader
+{
+    uint32_t magic;
+    uint32_t element_size;
+    uint64_t len;
+    char type_name[VECTOR_FILE_HEADER_SIZE - 16]; // NUL terminated
+};
+
+struct VectorMapping
+{
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+    unsigned char *base; // Start of the view, where the header lives
+    uint64_t size; // Bytes mapped, which is the size of the file
+    bool writable;
+};
+
+/////////////////////////////////////
+// Platform
+
+#ifdef _WIN32
+
+static bool VectorMapping$open(VectorMapping *this, const char *path, bool create)
+{
+    DWORD access = this->writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+    this->file = CreateFileA(path, access, FILE_SHARE_READ, NULL,
+                             create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (this->file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(this->file, &size))
+    {
+        CloseHandle(this->file);
+        return false;
+    }
+    this->size = (uint64_t)size.QuadPart;
+    return true;
+}
+
+static bool VectorMapping$resize(VectorMapping *this, uint64_t size)
+{
+    LARGE_INTEGER offset;
+    offset.QuadPart = (LONGLONG)size;
+    if (!SetFilePointerEx(this->file, offset, NULL, FILE_BEGIN) || !SetEndOfFile(this->file))
+    {
+        return false;
+    }
+    this->size = size;
+    return true;
+}
+
+static bool VectorMapping$map(VectorMapping *this)
+{
+    DWORD protect = this->writable ? PAGE_READWRITE : PAGE_READONLY;
+    this->mapping = CreateFileMappingA(this->file, NULL, protect,
+                                       (DWORD)(this->size >> 32), (DWORD)this->size, NULL);
+    if (!this->mapping)
+    {
+        return false;
+    }
+
+    DWORD access = this->writable ? FILE_MAP_WRITE : FILE_MAP_READ;
+    this->base = MapViewOfFile(this->mapping, access, 0, 0, (SIZE_T)this->size);
+    if (!this->base)
+    {
+        CloseHandle(this->mapping);
+        return false;
+    }
+    return true;
+}
+
+static void VectorMapping$unmap(VectorMapping *this)
+{
+    UnmapViewOfFile(this->base);
+    CloseHandle(this->mapping);
+    this->base = NULL;
+}
+
+static void VectorMapping$flush(VectorMapping *this)
+{
+    FlushViewOfFile(this->base, 0);
+    FlushFileBuffers(this->file);
+}
+
+static void VectorMapping$close(VectorMapping *this)
+{
+    CloseHandle(this->file);
+}
+
+#else
+
+static bool VectorMapping$open(VectorMapping *this, const char *path, bool create)
+{
+    int flags = this->writable ? O_RDWR : O_RDONLY;
+    if (create)
+    {
+        flags |= O_CREAT | O_TRUNC;
+    }
+
+    this->fd = open(path, flags, 0644);
+    if (this->fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(this->fd, &info) != 0)
+    {
+        close(this->fd);
+        return false;
+    }
+    this->size = (uint64_t)info.st_size;
+    return true;
+}
+
+static bool VectorMapping$resize(VectorMapping *this, uint64_t size)
+{
+    if (ftruncate(this->fd, (off_t)size) != 0)
+    {
+        return false;
+    }
+    this->size = size;
+    return true;
+}
+
+static bool VectorMapping$map(VectorMapping *this)
+{
+    int protect = this->writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *base = mmap(NULL, (size_t)this->size, protect, MAP_SHARED, this->fd, 0);
+    if (base == MAP_FAILED)
+    {
+        return false;
+    }
+    this->base = base;
+    return true;
+}
+
+static void VectorMapping$unmap(VectorMapping *this)
+{
+    munmap(this->base, (size_t)this->size);
+    this->base = NULL;
+}
+
+static void VectorMapping$flush(VectorMapping *this)
+{
+    msync(this->base, (size_t)this->size, MS_SYNC);
+}
+
+static void VectorMapping$close(VectorMapping *this)
+{
+    close(this->fd);
+}
+
+#endif
+
+/////////////////////////////////////
+// Vector files
+
+static VectorFileHeader *Vector$file_header(const Vector *this)
+{
+    return (VectorFileHeader *)this->mapping->base;
+}
+
+static bool Vector$can_map(const Type *type)
+{
+    return type->kind != TK_VOID && type->size &&
+           Type$has_traits(type, TT_TRIVIAL_COPY | TT_TRIVIAL_DESTROY);
+}
+
+// Points the vector at the mapping's elements
+static void Vector$attach(Vector *this, VectorMapping *mapping)
+{
+    this->mapping = mapping;
+    this->data = mapping->base + VECTOR_FILE_HEADER_SIZE;
+    this->cap = (size_t)((mapping->size - VECTOR_FILE_HEADER_SIZE) / this->member_type->size);
+}
+
+static bool Vector$open_file(Vector *out, const char *path, const Type *member_type,
+                             bool writable, bool create)
+{
+    VectorMapping *mapping = calloc(1, sizeof(VectorMapping));
+    assert(mapping && "Uh oh, failed to allocate memory!");
+    mapping->writable = writable;
+
+    if (!VectorMapping$open(mapping, path, create))
+    {
+        free(mapping);
+        return false;
+    }
+
+    if (create && !VectorMapping$resize(mapping, VECTOR_FILE_HEADER_SIZE))
+    {
+        VectorMapping$close(mapping);
+        free(mapping);
+        return false;
+    }
+
+    if (mapping->size < VECTOR_FILE_HEADER_SIZE || (uint64_t)(size_t)mapping->size != mapping->size ||
+        !VectorMapping$map(mapping))
+    {
+        VectorMapping$close(mapping);
+        free(mapping);
+        return false;
+    }
+
+    VectorFileHeader *header = (VectorFileHeader *)mapping->base;
+    if (create)
+    {
+        header->magic = VECTOR_FILE_MAGIC;
+        header->element_size = member_type->size;
+        header->len = 0;
+        memset(header->type_name, 0, sizeof(header->type_name));
+        strcpy(header->type_name, member_type->name);
+    }
+
+    // Check the header matches what we're expecting to find
+    bool valid = header->magic == VECTOR_FILE_MAGIC &&
+                 memchr(header->type_name, '\0', sizeof(header->type_name)) != NULL;
+    if (valid && !member_type)
+    {
+        member_type = Serial$find_type(header->type_name);
+    }
+    valid = valid && member_type && Vector$can_map(member_type) &&
+            strcmp(header->type_name, member_type->name) == 0 &&
+            header->element_size == member_type->size &&
+            header->len <= (mapping->size - VECTOR_FILE_HEADER_SIZE) / member_type->size;
+    if (!valid)
+    {
+        VectorMapping$unmap(mapping);
+        VectorMapping$close(mapping);
+        free(mapping);
+        return false;
+    }
+
+    Vector vec = { member_type };
+    vec.len = (size_t)header->len;
+    Vector$attach(&vec, mapping);
+    *out = vec;
+    return true;
+}
+
+bool Vector$map_file(Vector *out, const char *path, const Type *member_type, bool writable)
+{
+    return Vector$open_file(out, path, member_type, writable, false);
+}
+
+bool Vector$create_file(Vector *out, const char *path, const Type *member_type)
+{
+    assert(Vector$can_map(member_type) && "Only plain data can be kept in a vector file");
+    assert(strlen(member_type->name) < sizeof(((VectorFileHeader *)NULL)->type_name) &&
+           "Type name is too long for a vector file");
+
+    return Vector$open_file(out, path, member_type, true, true);
+}
+
+void Vector$sync_file(Vector *this)
+{
+    assert(this->mapping && "Vector$sync_file needs a mapped vector");
+    if (this->mapping->writable)
+    {
+        Vector$file_header(this)->len = this->len;
+        VectorMapping$flush(this->mapping);
+    }
+}
+
+void Vector$grow_mapped(Vector *this, size_t cap)
+{
+    VectorMapping *mapping = this->mapping;
+    assert(mapping->writable && "Can't grow a read only vector file");
+
+    // The view has to be dropped while the file changes size
+    Vector$file_header(this)->len = this->len;
+    VectorMapping$unmap(mapping);
+    bool ok = VectorMapping$resize(mapping, VECTOR_FILE_HEADER_SIZE + (uint64_t)cap * this->member_type->size) &&
+              VectorMapping$map(mapping);
+    assert(ok && "Uh oh, failed to grow the vector file!");
+
+    Vector$attach(this, mapping);
+}
+
+void Vector$unmap(Vector *this)
+{
+    VectorMapping *mapping = this->mapping;
+    if (mapping->writable)
+    {
+        // Trim the spare capacity off the end of the file
+        Vector$file_header(this)->len = this->len;
+        VectorMapping$unmap(mapping);
+        VectorMapping$resize(mapping, VECTOR_FILE_HEADER_SIZE + (uint64_t)this->len * this->member_type->size);
+    }
+    else
+    {
+        VectorMapping$unmap(mapping);
+    }
+
+    VectorMapping$close(mapping);
+    free(mapping);
+    this->mapping = NULL;
+}
@@ -0,0 +1,36 @@
+////////////////////////////////////////////
+// File    : vector_map.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "vector.h"
+#include <stdbool.h>
+
+// Vectors kept in memory mapped files. The file starts with a small
+// header recording the member type's name, the element size and the
+// length, and the elements follow it unchanged. Opening a file only
+// reads the header, and pages of elements are loaded as they're touched.
+//
+// Only plain data can be mapped: primitives, and complex types that are
+// TT_TRIVIAL_COPY and TT_TRIVIAL_DESTROY. Writable vectors grow the file
+// instead of reallocating. Vector$free records the final length,
+// trims the file to fit and unmaps it.
+
+// Bytes in front of the elements, which keeps them cache line aligned
+#define VECTOR_FILE_HEADER_SIZE 64
+
+// Opens an existing vector file. If member_type is NULL the type named by
+// the header is looked up with Serial$find_type. Returns false if the file
+// can't be mapped, isn't a vector file, or holds a different type.
+bool Vector$map_file(Vector *out, const char *path, const struct Type *member_type, bool writable);
+// Creates a writable vector file holding no elements, replacing any existing file
+bool Vector$create_file(Vector *out, const char *path, const struct Type *member_type);
+// Records the length in the header and flushes changed pages to disk
+void Vector$sync_file(Vector *this);
+
+// Used by vector.c for vectors with a mapping
+void Vector$grow_mapped(Vector *this, size_t cap);
+void Vector$unmap(Vector *this);
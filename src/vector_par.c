@@ -0,0 +1,288 @@
+////////////////////////////////////////////
+// File    : vector_par.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "vector_par.h"
+#include "rtti.h"
+#include "job.h"
+#include <string.h>
+#include <assert.h>
+
+#define VECTOR_PAR_CACHE_LINE 64
+// More chunks than threads, so threads that finish early steal the rest
+#define VECTOR_PAR_CHUNKS_PER_THREAD 4
+
+typedef struct VectorParOp VectorParOp;
+typedef struct VectorParTask VectorParTask;
+
+// Everything a call shares between its chunks
+struct VectorParOp
+{
+    const Vector *source;
+    Vector *dest;
+    void *context;
+
+    VectorEachFunc each;
+    VectorMapFunc map;
+    VectorCombineFunc combine;
+    VectorFilterFunc keep;
+
+    const void *identity;
+    bool *kept; // Per element filter results
+};
+
+struct VectorParTask
+{
+    const VectorParOp *op;
+    size_t begin;
+    size_t end;
+    size_t offset; // Where a filter chunk's kept elements go
+    size_t kept_count;
+    void *accum; // A reduce chunk's partial result
+};
+
+static size_t vector_par_threshold = VECTOR_PAR_THRESHOLD;
+
+void Vector$set_par_threshold(size_t count)
+{
+    vector_par_threshold = count;
+}
+
+static void *VectorPar$item(const Vector *vec, size_t idx)
+{
+    return (char *)vec->data + idx * vec->member_type->size;
+}
+
+static size_t VectorPar$gcd(size_t a, size_t b)
+{
+    while (b)
+    {
+        size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Splits len elements of the given size starting at data into chunks.
+// Chunk boundaries fall on cache line starts where the layout allows it,
+// so chunks being written by different threads never share a line.
+static VectorParTask *VectorPar$split(const VectorParOp *op, const void *data,
+                                      size_t size, size_t len, size_t *count)
+{
+    size_t threads = JobSystem$worker_count() + 1;
+    if (len < vector_par_threshold || threads == 1)
+    {
+        threads = 1;
+    }
+
+    // Chunks need a multiple of this many elements to cover whole lines
+    size_t line_items = VECTOR_PAR_CACHE_LINE / VectorPar$gcd(size ? size : 1, VECTOR_PAR_CACHE_LINE);
+    size_t target = threads == 1 ? 1 : threads * VECTOR_PAR_CHUNKS_PER_THREAD;
+    size_t step = (len + target - 1) / target;
+    step = (step + line_items - 1) / line_items * line_items;
+
+    // Shift the boundaries so they land where a line starts
+    size_t first = 0;
+    for (size_t i = 0; i < line_items; ++i)
+    {
+        if (((uintptr_t)data + i * size) % VECTOR_PAR_CACHE_LINE == 0)
+        {
+            first = i;
+            break;
+        }
+    }
+
+    size_t chunk_count = 1;
+    if (step && first + step < len)
+    {
+        chunk_count += (len - first - 1) / step;
+    }
+
+    VectorParTask *tasks = calloc(chunk_count, sizeof(VectorParTask));
+    assert(tasks && "Uh oh, failed to allocate memory!");
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        tasks[i].op = op;
+        tasks[i].begin = i ? first + i * step : 0;
+        tasks[i].end = i + 1 < chunk_count ? first + (i + 1) * step : len;
+    }
+
+    *count = chunk_count;
+    return tasks;
+}
+
+static void VectorPar$run(VectorParTask *tasks, size_t count, JobFunc func)
+{
+    if (count == 1)
+    {
+        func(&tasks[0]);
+        return;
+    }
+
+    JobCounter counter = JOB_COUNTER_INIT;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Job$run(func, &tasks[i], &counter);
+    }
+    JobCounter$wait(&counter);
+}
+
+/////////////////////////////////////
+// Chunk jobs
+
+static void VectorPar$each_chunk(void *data)
+{
+    VectorParTask *task = (VectorParTask *)data;
+    const VectorParOp *op = task->op;
+    for (size_t i = task->begin; i < task->end; ++i)
+    {
+        op->each(VectorPar$item(op->source, i), op->context);
+    }
+}
+
+static void VectorPar$map_chunk(void *data)
+{
+    VectorParTask *task = (VectorParTask *)data;
+    const VectorParOp *op = task->op;
+    for (size_t i = task->begin; i < task->end; ++i)
+    {
+        op->map(VectorPar$item(op->dest, i), VectorPar$item(op->source, i), op->context);
+    }
+}
+
+static void VectorPar$reduce_chunk(void *data)
+{
+    VectorParTask *task = (VectorParTask *)data;
+    const VectorParOp *op = task->op;
+    const Type *type = op->source->member_type;
+
+    task->accum = malloc(type->size ? type->size : 1);
+    assert(task->accum && "Uh oh, failed to allocate memory!");
+    Type$copy_value(type, task->accum, op->identity);
+
+    for (size_t i = task->begin; i < task->end; ++i)
+    {
+        op->combine(task->accum, VectorPar$item(op->source, i), op->context);
+    }
+}
+
+static void VectorPar$filter_test_chunk(void *data)
+{
+    VectorParTask *task = (VectorParTask *)data;
+    const VectorParOp *op = task->op;
+    size_t kept_count = 0;
+    for (size_t i = task->begin; i < task->end; ++i)
+    {
+        op->kept[i] = op->keep(VectorPar$item(op->source, i), op->context);
+        kept_count += op->kept[i];
+    }
+    task->kept_count = kept_count;
+}
+
+static void VectorPar$filter_copy_chunk(void *data)
+{
+    VectorParTask *task = (VectorParTask *)data;
+    const VectorParOp *op = task->op;
+    const Type *type = op->source->member_type;
+
+    size_t out = task->offset;
+    for (size_t i = task->begin; i < task->end; ++i)
+    {
+        if (op->kept[i])
+        {
+            Type$copy_value(type, VectorPar$item(op->dest, out++), VectorPar$item(op->source, i));
+        }
+    }
+}
+
+/////////////////////////////////////
+// Public interface
+
+void Vector$par_for_each(Vector *this, VectorEachFunc func, void *context)
+{
+    VectorParOp op = { this };
+    op.each = func;
+    op.context = context;
+
+    size_t count;
+    VectorParTask *tasks = VectorPar$split(&op, this->data, this->member_type->size, this->len, &count);
+    VectorPar$run(tasks, count, VectorPar$each_chunk);
+    free(tasks);
+}
+
+Vector Vector$par_map(const Vector *this, const Type *result_type, VectorMapFunc map, void *context)
+{
+    Vector result = Vector$new(result_type);
+    Vector$reserve(&result, this->len);
+
+    VectorParOp op = { this, &result };
+    op.map = map;
+    op.context = context;
+
+    // Split on the results, they're what gets written
+    size_t count;
+    VectorParTask *tasks = VectorPar$split(&op, result.data, result_type->size, this->len, &count);
+    VectorPar$run(tasks, count, VectorPar$map_chunk);
+    free(tasks);
+
+    result.len = this->len;
+    return result;
+}
+
+void Vector$par_reduce(const Vector *this, void *result, const void *identity,
+                       VectorCombineFunc combine, void *context)
+{
+    VectorParOp op = { this };
+    op.combine = combine;
+    op.identity = identity;
+    op.context = context;
+
+    size_t count;
+    VectorParTask *tasks = VectorPar$split(&op, this->data, this->member_type->size, this->len, &count);
+    VectorPar$run(tasks, count, VectorPar$reduce_chunk);
+
+    // Fold the partial results together in order
+    const Type *type = this->member_type;
+    Type$copy_value(type, result, identity);
+    for (size_t i = 0; i < count; ++i)
+    {
+        combine(result, tasks[i].accum, context);
+        Type$destroy_value(type, tasks[i].accum);
+        free(tasks[i].accum);
+    }
+    free(tasks);
+}
+
+Vector Vector$par_filter(const Vector *this, VectorFilterFunc keep, void *context)
+{
+    Vector result = Vector$new(this->member_type);
+
+    VectorParOp op = { this, &result };
+    op.keep = keep;
+    op.context = context;
+    op.kept = malloc(this->len ? this->len : 1);
+    assert(op.kept && "Uh oh, failed to allocate memory!");
+
+    // Test everything first, so each chunk knows where its elements go
+    size_t count;
+    VectorParTask *tasks = VectorPar$split(&op, this->data, this->member_type->size, this->len, &count);
+    VectorPar$run(tasks, count, VectorPar$filter_test_chunk);
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        tasks[i].offset = total;
+        total += tasks[i].kept_count;
+    }
+
+    Vector$reserve(&result, total);
+    VectorPar$run(tasks, count, VectorPar$filter_copy_chunk);
+    result.len = total;
+
+    free(tasks);
+    free(op.kept);
+    return result;
+}
@@ -0,0 +1,37 @@
+////////////////////////////////////////////
+// File    : vector_par.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "vector.h"
+#include <stdbool.h>
+
+// Data-parallel operations over a Vector, run on the job system.
+// Each call splits the vector into chunks that start on cache line
+// boundaries and waits for them, helping out on the calling thread.
+// Vectors shorter than the threshold, or calls made without a running
+// job system, run serially on the calling thread.
+
+// Elements below which operations run serially
+#define VECTOR_PAR_THRESHOLD 4096
+void Vector$set_par_threshold(size_t count);
+
+typedef void (*VectorEachFunc)(void *item, void *context);
+// Constructs the result for item in place
+typedef void (*VectorMapFunc)(void *result, const void *item, void *context);
+// Folds value into accum. Must be associative, as chunks are
+// combined in order but grouped arbitrarily.
+typedef void (*VectorCombineFunc)(void *accum, const void *value, void *context);
+typedef bool (*VectorFilterFunc)(const void *item, void *context);
+
+void   Vector$par_for_each(Vector *this, VectorEachFunc func, void *context);
+Vector Vector$par_map(const Vector *this, const struct Type *result_type,
+                      VectorMapFunc map, void *context);
+// result receives a new member_type value, each chunk starts from a copy of identity
+void   Vector$par_reduce(const Vector *this, void *result, const void *identity,
+                         VectorCombineFunc combine, void *context);
+// Copies of the kept elements, in their original order
+Vector Vector$par_filter(const Vector *this, VectorFilterFunc keep, void *context);
@@ -0,0 +1,628 @@
+////////////////////////////////////////////
+// File    : vector_sort.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "vector_sort.h"
+#include "rtti.h"
+#include "string.h"
+#include "job.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+// Ranges this short are insertion sorted
+#define SORT_INSERTION_MAX 16
+// Below this a comparison sort beats the radix passes
+#define SORT_RADIX_MIN 64
+
+typedef enum RadixKind RadixKind;
+typedef struct SortContext SortContext;
+typedef struct SortTask SortTask;
+typedef int (*SortCompare)(const SortContext *ctx, const void *lhs, const void *rhs);
+
+enum RadixKind
+{
+    RK_NONE, // Needs a comparison sort
+    RK_UNSIGNED,
+    RK_SIGNED,
+    RK_FLOAT,
+};
+
+struct SortContext
+{
+    const Type *type;
+    size_t size;
+    SortCompare compare;
+    const Member *cmp; // Resolved once for complex types
+    RadixKind radix;
+};
+
+// One chunk sort or one merge of a parallel sort
+struct SortTask
+{
+    const SortContext *ctx;
+    unsigned char *src;
+    unsigned char *dst;
+    unsigned char *tmp;
+    size_t lo;
+    size_t mid;
+    size_t hi;
+};
+
+/////////////////////////////////////
+// Comparisons
+
+static int Sort$compare_string(const SortContext *ctx, const void *lhs, const void *rhs)
+{
+    (ctx); // unused
+    return String$compare(*(const String *)lhs, *(const String *)rhs);
+}
+
+static int Sort$compare_member(const SortContext *ctx, const void *lhs, const void *rhs)
+{
+    Any other = Any$ref_complex(ctx->type, (void *)rhs);
+    Any result = Member$invoke(ctx->cmp, (void *)lhs, 1, &other);
+    return result.value.i32;
+}
+
+static int Sort$compare_value(const SortContext *ctx, const void *lhs, const void *rhs)
+{
+    return Type$compare_values(ctx->type, lhs, rhs);
+}
+
+static RadixKind Sort$radix_kind(const Type *type)
+{
+    if (type->kind == TK_COMPLEX || type->kind == TK_VOID || type == &type_cstr)
+    {
+        return RK_NONE;
+    }
+    if (type->size != 1 && type->size != 2 && type->size != 4 && type->size != 8)
+    {
+        return RK_NONE;
+    }
+
+    if (type == &type_float || type == &type_double)
+    {
+        return RK_FLOAT;
+    }
+    if (type == &type_int8_t || type == &type_int16_t ||
+        type == &type_int32_t || type == &type_int64_t)
+    {
+        return RK_SIGNED;
+    }
+    return RK_UNSIGNED;
+}
+
+static SortContext Sort$context(const Type *type)
+{
+    SortContext ctx = { type, type->size };
+    ctx.radix = Sort$radix_kind(type);
+
+    if (type == &type_string)
+    {
+        ctx.compare = Sort$compare_string;
+    }
+    else if (type->kind == TK_COMPLEX)
+    {
+        ctx.cmp = Type$find_member(type, ".cmp");
+        assert(ctx.cmp && "Type has no .cmp member to sort with");
+        ctx.compare = Sort$compare_member;
+    }
+    else
+    {
+        ctx.compare = Sort$compare_value;
+    }
+    return ctx;
+}
+
+/////////////////////////////////////
+// Radix sort
+
+static uint64_t Sort$load(const unsigned char *item, size_t size)
+{
+    uint64_t key = 0;
+    memcpy(&key, item, size);
+    return key;
+}
+
+#define RADIX_ENCODE(T)                                         \
+    {                                                           \
+        T *keys = (T *)base;                                    \
+        const T top = (T)((T)1 << (sizeof(T) * 8 - 1));         \
+        for (size_t i = 0; i < n; ++i)                          \
+        {                                                       \
+            T key = keys[i];                                    \
+            if (kind == RK_SIGNED)                              \
+            {                                                   \
+                key ^= top;                                     \
+            }                                                   \
+            else if (!decode)                                   \
+            {                                                   \
+                key = (key & top) ? (T)~key : (T)(key | top);   \
+            }                                                   \
+            else                                                \
+            {                                                   \
+                key = (key & top) ? (T)(key & ~top) : (T)~key;  \
+            }                                                   \
+            keys[i] = key;                                      \
+        }                                                       \
+        break;                                                  \
+    }
+
+// Rewrites keys so that comparing them as unsigned integers
+// matches comparing their values, or undoes that. Negative
+// floats order backwards, so all of their bits get flipped.
+static void Sort$radix_encode(unsigned char *base, size_t n, size_t size, RadixKind kind, bool decode)
+{
+    if (kind == RK_UNSIGNED)
+    {
+        return;
+    }
+
+    switch (size)
+    {
+        case 1: RADIX_ENCODE(uint8_t)
+        case 2: RADIX_ENCODE(uint16_t)
+        case 4: RADIX_ENCODE(uint32_t)
+        default: RADIX_ENCODE(uint64_t)
+    }
+}
+
+#define RADIX_COUNT(T)                                          \
+    {                                                           \
+        const T *keys = (const T *)base;                        \
+        for (size_t i = 0; i < n; ++i)                          \
+        {                                                       \
+            T key = keys[i];                                    \
+            for (size_t b = 0; b < size; ++b)                   \
+            {                                                   \
+                counts[b][(key >> (b * 8)) & 0xFF]++;           \
+            }                                                   \
+        }                                                       \
+        break;                                                  \
+    }
+
+#define RADIX_SCATTER(T)                                        \
+    {                                                           \
+        const T *from = (const T *)src;                         \
+        T *to = (T *)dst;                                       \
+        for (size_t i = 0; i < n; ++i)                          \
+        {                                                       \
+            T key = from[i];                                    \
+            to[count[(key >> shift) & 0xFF]++] = key;           \
+        }                                                       \
+        break;                                                  \
+    }
+
+// LSD radix sort a byte at a time. It's stable, so it
+// serves both Vector$sort and Vector$sort_stable.
+static void Sort$radix(unsigned char *base, size_t n, size_t size, RadixKind kind, unsigned char *scratch)
+{
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    Sort$radix_encode(base, n, size, kind, false);
+
+    // Count every digit in one pass over the keys
+    switch (size)
+    {
+        case 1: RADIX_COUNT(uint8_t)
+        case 2: RADIX_COUNT(uint16_t)
+        case 4: RADIX_COUNT(uint32_t)
+        default: RADIX_COUNT(uint64_t)
+    }
+
+    unsigned char *src = base;
+    unsigned char *dst = scratch;
+    for (size_t b = 0; b < size; ++b)
+    {
+        size_t *count = counts[b];
+        unsigned shift = (unsigned)(b * 8);
+
+        // Skip digits every key shares, like the high bytes of small numbers
+        if (count[(Sort$load(src, size) >> shift) & 0xFF] == n)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (unsigned digit = 0; digit < 256; ++digit)
+        {
+            size_t digit_count = count[digit];
+            count[digit] = offset;
+            offset += digit_count;
+        }
+
+        switch (size)
+        {
+            case 1: RADIX_SCATTER(uint8_t)
+            case 2: RADIX_SCATTER(uint16_t)
+            case 4: RADIX_SCATTER(uint32_t)
+            default: RADIX_SCATTER(uint64_t)
+        }
+
+        unsigned char *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != base)
+    {
+        memcpy(base, src, n * size);
+    }
+    Sort$radix_encode(base, n, size, kind, true);
+}
+
+/////////////////////////////////////
+// Comparison sorts
+
+static void Sort$swap(unsigned char *a, unsigned char *b, size_t size, unsigned char *tmp)
+{
+    memcpy(tmp, a, size);
+    memcpy(a, b, size);
+    memcpy(b, tmp, size);
+}
+
+static void Sort$insertion(unsigned char *base, size_t n, const SortContext *ctx, unsigned char *tmp)
+{
+    size_t size = ctx->size;
+    for (size_t i = 1; i < n; ++i)
+    {
+        size_t j = i;
+        memcpy(tmp, base + i * size, size);
+        while (j > 0 && ctx->compare(ctx, tmp, base + (j - 1) * size) < 0)
+        {
+            memcpy(base + j * size, base + (j - 1) * size, size);
+            --j;
+        }
+        memcpy(base + j * size, tmp, size);
+    }
+}
+
+static void Sort$sift_down(unsigned char *base, size_t root, size_t n,
+                           const SortContext *ctx, unsigned char *tmp)
+{
+    size_t size = ctx->size;
+    for (;;)
+    {
+        size_t child = root * 2 + 1;
+        if (child >= n)
+        {
+            return;
+        }
+        if (child + 1 < n && ctx->compare(ctx, base + child * size, base + (child + 1) * size) < 0)
+        {
+            ++child;
+        }
+        if (ctx->compare(ctx, base + root * size, base + child * size) >= 0)
+        {
+            return;
+        }
+
+        Sort$swap(base + root * size, base + child * size, size, tmp);
+        root = child;
+    }
+}
+
+static void Sort$heapsort(unsigned char *base, size_t n, const SortContext *ctx, unsigned char *tmp)
+{
+    for (size_t i = n / 2; i-- > 0;)
+    {
+        Sort$sift_down(base, i, n, ctx, tmp);
+    }
+    for (size_t end = n - 1; end > 0; --end)
+    {
+        Sort$swap(base, base + end * ctx->size, ctx->size, tmp);
+        Sort$sift_down(base, 0, end, ctx, tmp);
+    }
+}
+
+// Quicksort that falls back to heapsort when the partitions go bad
+static void Sort$intro(unsigned char *base, size_t n, const SortContext *ctx, unsigned depth,
+                       unsigned char *tmp, unsigned char *pivot)
+{
+    size_t size = ctx->size;
+    while (n > SORT_INSERTION_MAX)
+    {
+        if (!depth--)
+        {
+            Sort$heapsort(base, n, ctx, tmp);
+            return;
+        }
+
+        // Median of three, which also keeps both scans inside the range
+        unsigned char *first = base;
+        unsigned char *mid = base + n / 2 * size;
+        unsigned char *last = base + (n - 1) * size;
+        if (ctx->compare(ctx, mid, first) < 0)
+        {
+            Sort$swap(mid, first, size, tmp);
+        }
+        if (ctx->compare(ctx, last, mid) < 0)
+        {
+            Sort$swap(last, mid, size, tmp);
+            if (ctx->compare(ctx, mid, first) < 0)
+            {
+                Sort$swap(mid, first, size, tmp);
+            }
+        }
+        memcpy(pivot, mid, size);
+
+        // Hoare partition into [0, j] and [j + 1, n)
+        ptrdiff_t i = -1;
+        ptrdiff_t j = (ptrdiff_t)n;
+        for (;;)
+        {
+            do { ++i; } while (ctx->compare(ctx, base + i * size, pivot) < 0);
+            do { --j; } while (ctx->compare(ctx, pivot, base + j * size) < 0);
+            if (i >= j)
+            {
+                break;
+            }
+            Sort$swap(base + i * size, base + j * size, size, tmp);
+        }
+
+        // Recurse into the smaller side so the stack stays shallow
+        size_t left = (size_t)j + 1;
+        size_t right = n - left;
+        if (left < right)
+        {
+            Sort$intro(base, left, ctx, depth, tmp, pivot);
+            base += left * size;
+            n = right;
+        }
+        else
+        {
+            Sort$intro(base + left * size, right, ctx, depth, tmp, pivot);
+            n = left;
+        }
+    }
+
+    Sort$insertion(base, n, ctx, tmp);
+}
+
+// Stable merge, ties take from the left
+static void Sort$merge(const SortContext *ctx, unsigned char *dst,
+                       const unsigned char *left, size_t left_n,
+                       const unsigned char *right, size_t right_n)
+{
+    size_t size = ctx->size;
+    while (left_n && right_n)
+    {
+        if (ctx->compare(ctx, right, left) < 0)
+        {
+            memcpy(dst, right, size);
+            right += size;
+            --right_n;
+        }
+        else
+        {
+            memcpy(dst, left, size);
+            left += size;
+            --left_n;
+        }
+        dst += size;
+    }
+
+    memcpy(dst, left, left_n * size);
+    memcpy(dst + left_n * size, right, right_n * size);
+}
+
+// Bottom up merge sort, bouncing between base and scratch
+static void Sort$merge_sort(unsigned char *base, size_t n, const SortContext *ctx,
+                            unsigned char *scratch, unsigned char *tmp)
+{
+    size_t size = ctx->size;
+    for (size_t i = 0; i < n; i += SORT_INSERTION_MAX)
+    {
+        size_t run = n - i < SORT_INSERTION_MAX ? n - i : SORT_INSERTION_MAX;
+        Sort$insertion(base + i * size, run, ctx, tmp);
+    }
+
+    unsigned char *src = base;
+    unsigned char *dst = scratch;
+    for (size_t width = SORT_INSERTION_MAX; width < n; width *= 2)
+    {
+        for (size_t lo = 0; lo < n; lo += 2 * width)
+        {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            Sort$merge(ctx, dst + lo * size, src + lo * size, mid - lo, src + mid * size, hi - mid);
+        }
+
+        unsigned char *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != base)
+    {
+        memcpy(base, src, n * size);
+    }
+}
+
+static void Sort$stable_range(unsigned char *base, size_t n, const SortContext *ctx,
+                              unsigned char *scratch, unsigned char *tmp)
+{
+    if (ctx->radix != RK_NONE && n >= SORT_RADIX_MIN)
+    {
+        Sort$radix(base, n, ctx->size, ctx->radix, scratch);
+    }
+    else
+    {
+        Sort$merge_sort(base, n, ctx, scratch, tmp);
+    }
+}
+
+static unsigned char *Sort$alloc(size_t bytes)
+{
+    unsigned char *block = malloc(bytes ? bytes : 1);
+    assert(block && "Uh oh, failed to allocate memory!");
+    return block;
+}
+
+/////////////////////////////////////
+// Parallel merge sort
+
+static void Sort$chunk_job(void *data)
+{
+    SortTask *task = (SortTask *)data;
+    size_t size = task->ctx->size;
+    Sort$stable_range(task->src + task->lo * size, task->hi - task->lo, task->ctx,
+                      task->dst + task->lo * size, task->tmp);
+}
+
+static void Sort$merge_job(void *data)
+{
+    SortTask *task = (SortTask *)data;
+    size_t size = task->ctx->size;
+    Sort$merge(task->ctx, task->dst + task->lo * size,
+               task->src + task->lo * size, task->mid - task->lo,
+               task->src + task->mid * size, task->hi - task->mid);
+}
+
+/////////////////////////////////////
+// Public interface
+
+void Vector$sort(Vector *this)
+{
+    size_t n = this->len;
+    if (n < 2)
+    {
+        return;
+    }
+
+    SortContext ctx = Sort$context(this->member_type);
+    if (ctx.radix != RK_NONE && n >= SORT_RADIX_MIN)
+    {
+        unsigned char *scratch = Sort$alloc(n * ctx.size);
+        Sort$radix(this->data, n, ctx.size, ctx.radix, scratch);
+        free(scratch);
+        return;
+    }
+
+    unsigned depth = 0;
+    for (size_t i = n; i > 1; i /= 2)
+    {
+        depth += 2;
+    }
+
+    unsigned char *tmp = Sort$alloc(2 * ctx.size);
+    Sort$intro(this->data, n, &ctx, depth, tmp, tmp + ctx.size);
+    free(tmp);
+}
+
+void Vector$sort_stable(Vector *this)
+{
+    size_t n = this->len;
+    if (n < 2)
+    {
+        return;
+    }
+
+    SortContext ctx = Sort$context(this->member_type);
+    unsigned char *scratch = Sort$alloc((n + 1) * ctx.size);
+    Sort$stable_range(this->data, n, &ctx, scratch, scratch + n * ctx.size);
+    free(scratch);
+}
+
+void Vector$par_sort(Vector *this)
+{
+    size_t n = this->len;
+    size_t chunks = JobSystem$worker_count() + 1;
+    if (n < VECTOR_PAR_SORT_THRESHOLD || chunks == 1)
+    {
+        Vector$sort_stable(this);
+        return;
+    }
+
+    SortContext ctx = Sort$context(this->member_type);
+    size_t size = ctx.size;
+    unsigned char *scratch = Sort$alloc(n * size);
+    unsigned char *tmps = Sort$alloc(chunks * size);
+    size_t *bounds = malloc((chunks + 1) * sizeof(size_t));
+    SortTask *tasks = malloc(chunks * sizeof(SortTask));
+    assert(bounds && tasks && "Uh oh, failed to allocate memory!");
+
+    // Sort one chunk per thread
+    JobCounter counter = JOB_COUNTER_INIT;
+    for (size_t i = 0; i <= chunks; ++i)
+    {
+        bounds[i] = n / chunks * i + (i == chunks ? n % chunks : 0);
+    }
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        SortTask task = { &ctx, this->data, scratch, tmps + i * size, bounds[i], bounds[i], bounds[i + 1] };
+        tasks[i] = task;
+        Job$run(Sort$chunk_job, &tasks[i], &counter);
+    }
+    JobCounter$wait(&counter);
+
+    // Then merge neighbouring runs in parallel until one is left
+    unsigned char *src = this->data;
+    unsigned char *dst = scratch;
+    size_t runs = chunks;
+    while (runs > 1)
+    {
+        size_t merged = 0;
+        for (size_t r = 0; r < runs; r += 2)
+        {
+            size_t hi = r + 2 <= runs ? bounds[r + 2] : bounds[r + 1];
+            SortTask task = { &ctx, src, dst, NULL, bounds[r], bounds[r + 1], hi };
+            tasks[merged] = task;
+            Job$run(Sort$merge_job, &tasks[merged], &counter);
+            bounds[merged++] = bounds[r];
+        }
+        JobCounter$wait(&counter);
+
+        bounds[merged] = n;
+        runs = merged;
+
+        unsigned char *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != this->data)
+    {
+        memcpy(this->data, src, n * size);
+    }
+
+    free(tasks);
+    free(bounds);
+    free(tmps);
+    free(scratch);
+}
+
+size_t Vector$lower_bound(const Vector *this, const void *value)
+{
+    SortContext ctx = Sort$context(this->member_type);
+    size_t lo = 0;
+    size_t hi = this->len;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ctx.compare(&ctx, (char *)this->data + mid * ctx.size, value) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+size_t Vector$binary_search(const Vector *this, const void *value)
+{
+    size_t pos = Vector$lower_bound(this, value);
+    if (pos < this->len &&
+        Type$compare_values(this->member_type, (char *)this->data + pos * this->member_type->size, value) == 0)
+    {
+        return pos;
+    }
+    return VECTOR_NPOS;
+}
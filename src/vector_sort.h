@@ -0,0 +1,31 @@
+////////////////////////////////////////////
+// File    : vector_sort.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "vector.h"
+
+// Sorting and searching driven by the Vector's member_type. Primitives
+// are radix sorted, and everything else is ordered by Type$compare_values.
+// Elements are moved around with memcpy.
+
+// Searches return VECTOR_NPOS when nothing is found
+#define VECTOR_NPOS ((size_t)-1)
+
+void Vector$sort(Vector *this);
+// Equal elements keep their original order
+void Vector$sort_stable(Vector *this);
+// Stable merge sort across the job system, for very large vectors.
+// Falls back to Vector$sort_stable below VECTOR_PAR_SORT_THRESHOLD
+// elements or when no job system is running.
+#define VECTOR_PAR_SORT_THRESHOLD (64 * 1024)
+void Vector$par_sort(Vector *this);
+
+// The vector must be sorted. First position value could be inserted
+// at without breaking the order.
+size_t Vector$lower_bound(const Vector *this, const void *value);
+// Position of an element equal to value, or VECTOR_NPOS
+size_t Vector$binary_search(const Vector *this, const void *value);
@@ -0,0 +1,72 @@
+////////////////////////////////////////////
+// File    : vector_typed.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "vector.h"
+#include "rtti.h"
+#include <assert.h>
+
+// Typed front ends for Vector with the element size known at compile time.
+// They work on plain Vectors, so typed and reflective code can share one.
+//
+//   VECTOR_DEFINE(float)
+//   Vector v = Vector_float$new();
+//   Vector_float$push(&v, 1.0f);
+//   float *data = Vector_float$data(&v);
+//
+// VECTOR_DEFINE(T) uses the type_T descriptor. Use VECTOR_DEFINE_TYPE
+// when the name or descriptor don't follow that pattern:
+//
+//   VECTOR_DEFINE_TYPE(String, String, type_string)
+
+#define VECTOR_DEFINE(T) VECTOR_DEFINE_TYPE(T, T, type_##T)
+
+#define VECTOR_DEFINE_TYPE(Name, T, type_desc)                                  \
+    static inline Vector Vector_##Name##$new(void)                              \
+    {                                                                           \
+        return Vector$new(&type_desc);                                          \
+    }                                                                           \
+                                                                                \
+    static inline T *Vector_##Name##$data(const Vector *this)                  \
+    {                                                                           \
+        assert(this->member_type == &type_desc && "Vector holds another type"); \
+        return (T *)this->data;                                                 \
+    }                                                                           \
+                                                                                \
+    static inline size_t Vector_##Name##$len(const Vector *this)               \
+    {                                                                           \
+        return this->len;                                                       \
+    }                                                                           \
+                                                                                \
+    static inline T Vector_##Name##$get(const Vector *this, size_t idx)        \
+    {                                                                           \
+        assert(idx < this->len);                                                \
+        return Vector_##Name##$data(this)[idx];                                 \
+    }                                                                           \
+                                                                                \
+    /* Overwrites the element without destroying the old value */              \
+    static inline void Vector_##Name##$set(Vector *this, size_t idx, T item)   \
+    {                                                                           \
+        assert(idx < this->len);                                                \
+        Vector_##Name##$data(this)[idx] = item;                                 \
+    }                                                                           \
+                                                                                \
+    static inline void Vector_##Name##$push(Vector *this, T item)              \
+    {                                                                           \
+        /* Only growing goes through the generic code */                        \
+        if (this->len == this->cap)                                             \
+        {                                                                       \
+            Vector$reserve(this, this->len + 1);                                \
+        }                                                                       \
+        Vector_##Name##$data(this)[this->len++] = item;                         \
+    }                                                                           \
+                                                                                \
+    static inline T Vector_##Name##$pop(Vector *this)                          \
+    {                                                                           \
+        assert(this->len);                                                      \
+        return Vector_##Name##$data(this)[--this->len];                         \
+    }
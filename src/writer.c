@@ -0,0 +1,190 @@
+////////////////////////////////////////////
+// File    : writer.c
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#include "writer.h"
+#include "format.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+static Writer Writer$new(WriterTarget target, char *buffer, size_t size)
+{
+    Writer writer = { target };
+    if (!buffer)
+    {
+        size = WRITER_BUFFER_SIZE;
+        buffer = malloc(size);
+        assert(buffer && "Uh oh, failed to allocate memory!");
+        writer.owns_buffer = true;
+    }
+
+    writer.buffer = buffer;
+    writer.cap = size;
+    return writer;
+}
+
+Writer Writer$to_file(FILE *stream, char *buffer, size_t size)
+{
+    Writer writer = Writer$new(WT_FILE, buffer, size);
+    writer.stream = stream;
+    return writer;
+}
+
+Writer Writer$to_string(String *string, char *buffer, size_t size)
+{
+    Writer writer = Writer$new(WT_STRING, buffer, size);
+    writer.string = string;
+    return writer;
+}
+
+Writer Writer$to_buffer(char *buffer, size_t size)
+{
+    assert(buffer && size && "Writer$to_buffer needs room for at least the NUL");
+
+    // Leave room for the NUL
+    Writer writer = Writer$new(WT_BUFFER, buffer, size - 1);
+    buffer[0] = 0;
+    return writer;
+}
+
+void Writer$flush(Writer *this)
+{
+    switch (this->target)
+    {
+        case WT_FILE:
+        {
+            fwrite(this->buffer, 1, this->used, this->stream);
+            this->used = 0;
+            break;
+        }
+        case WT_STRING:
+        {
+            // Borrow the buffer as a literal String
+            String text = { this->buffer, this->used, 0 };
+            String$append(this->string, text);
+            this->used = 0;
+            break;
+        }
+        case WT_BUFFER:
+        {
+            // The text stays where it is
+            this->buffer[this->used] = 0;
+            break;
+        }
+    }
+}
+
+void Writer$close(Writer *this)
+{
+    Writer$flush(this);
+    if (this->owns_buffer)
+    {
+        free(this->buffer);
+    }
+    this->buffer = NULL;
+    this->cap = 0;
+}
+
+// Slow path of Writer$write, when the buffer is full
+static void Writer$spill(Writer *this, const char *data, size_t len)
+{
+    if (this->target == WT_BUFFER)
+    {
+        size_t room = this->cap - this->used;
+        memcpy(this->buffer + this->used, data, room);
+        this->used = this->cap;
+        this->truncated = true;
+        this->buffer[this->used] = 0;
+        return;
+    }
+
+    Writer$flush(this);
+
+    // Blocks bigger than the buffer go straight through
+    if (len >= this->cap)
+    {
+        if (this->target == WT_FILE)
+        {
+            fwrite(data, 1, len, this->stream);
+        }
+        else
+        {
+            String text = { (char *)data, len, 0 };
+            String$append(this->string, text);
+        }
+        return;
+    }
+
+    memcpy(this->buffer, data, len);
+    this->used = len;
+}
+
+void Writer$write(Writer *this, const void *data, size_t len)
+{
+    if (len <= this->cap - this->used)
+    {
+        memcpy(this->buffer + this->used, data, len);
+        this->used += len;
+        if (this->target == WT_BUFFER)
+        {
+            this->buffer[this->used] = 0;
+        }
+        return;
+    }
+
+    Writer$spill(this, (const char *)data, len);
+}
+
+void Writer$char(Writer *this, char c)
+{
+    Writer$write(this, &c, 1);
+}
+
+void Writer$cstr(Writer *this, const char *cstr)
+{
+    Writer$write(this, cstr, strlen(cstr));
+}
+
+void Writer$string(Writer *this, String str)
+{
+    Writer$write(this, String$cstr(&str), String$len(&str));
+}
+
+void Writer$int(Writer *this, int64_t value)
+{
+    char digits[FORMAT_NUMBER_MAX];
+    Writer$write(this, digits, Format$int(digits, value));
+}
+
+void Writer$uint(Writer *this, uint64_t value)
+{
+    char digits[FORMAT_NUMBER_MAX];
+    Writer$write(this, digits, Format$uint(digits, value));
+}
+
+void Writer$hex(Writer *this, uint64_t value)
+{
+    char digits[FORMAT_NUMBER_MAX];
+    Writer$write(this, digits, Format$hex(digits, value));
+}
+
+void Writer$double(Writer *this, double value)
+{
+    char digits[FORMAT_NUMBER_MAX];
+    Writer$write(this, digits, Format$double(digits, value));
+}
+
+void Writer$float(Writer *this, float value)
+{
+    char digits[FORMAT_NUMBER_MAX];
+    Writer$write(this, digits, Format$float(digits, value));
+}
+
+void Writer$pointer(Writer *this, const void *ptr)
+{
+    Writer$write(this, "0x", 2);
+    Writer$hex(this, (uint64_t)(uintptr_t)ptr);
+}
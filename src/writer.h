@@ -0,0 +1,63 @@
+////////////////////////////////////////////
+// File    : writer.h
+// Author  : Connor Hilarides
+// Created : 2026/10/16
+////////////////////////////////////////////
+
+#pragma once
+
+#include "string.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum WriterTarget WriterTarget;
+typedef struct Writer Writer;
+
+// Buffered text output. Writers gather text in a buffer and hand it on
+// in large blocks, and format numbers with format.h instead of printf.
+//
+// File and String writers use the buffer they're given, or allocate one
+// when buffer is NULL. Call Writer$close when done to flush and free it.
+#define WRITER_BUFFER_SIZE (64 * 1024)
+Writer Writer$to_file(FILE *stream, char *buffer, size_t size);
+// Appends to string
+Writer Writer$to_string(String *string, char *buffer, size_t size);
+// Writes into buffer, which is kept NUL terminated. Text that doesn't
+// fit is dropped and truncated is set.
+Writer Writer$to_buffer(char *buffer, size_t size);
+
+// Hands the buffered text on to the target
+void Writer$flush(Writer *this);
+void Writer$close(Writer *this);
+
+void Writer$write(Writer *this, const void *data, size_t len);
+void Writer$char(Writer *this, char c);
+void Writer$cstr(Writer *this, const char *cstr);
+void Writer$string(Writer *this, String str);
+void Writer$int(Writer *this, int64_t value);
+void Writer$uint(Writer *this, uint64_t value);
+void Writer$hex(Writer *this, uint64_t value);
+// Shortest round-trip, see Format$double
+void Writer$double(Writer *this, double value);
+void Writer$float(Writer *this, float value);
+void Writer$pointer(Writer *this, const void *ptr);
+
+enum WriterTarget
+{
+    WT_FILE,
+    WT_STRING,
+    WT_BUFFER,
+};
+
+struct Writer
+{
+    WriterTarget target;
+    char *buffer;
+    size_t used;
+    size_t cap;
+    FILE *stream; // WT_FILE
+    String *string; // WT_STRING
+    bool owns_buffer;
+    bool truncated; // WT_BUFFER ran out of room
+};